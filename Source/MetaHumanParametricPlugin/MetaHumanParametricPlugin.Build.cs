@@ -56,6 +56,7 @@ public class MetaHumanParametricPlugin : ModuleRules
 				"ToolMenus",
 				"EditorWidgets",
 				"LevelEditor",
+				"ImageCore",
 
 				// 资产相关
 				"AssetRegistry",
@@ -3,25 +3,61 @@
 #include "EditorBatchGenerationSubsystem.h"
 #include "MetaHumanCharacter.h"
 #include "MetaHumanBodyType.h"
+#include "MetaHumanConfigSerializer.h"
+#include "MetaHumanRigCache.h"
+#include "MetaHumanTextureCache.h"
+#include "MetaHumanWardrobePreloader.h"
 #include "Misc/DateTime.h"
 #include "Containers/Ticker.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+
+namespace BatchGenStage
+{
+	static const FName WardrobePreload(TEXT("WardrobePreload"));
+	static const FName Prepare(TEXT("Prepare"));
+	static const FName PrepareCreateCharacter(TEXT("Prepare.CreateCharacter"));
+	static const FName PreparePrototypeInit(TEXT("Prepare.PrototypeInit"));
+	static const FName PreparePreviewBuild(TEXT("Prepare.PreviewBuild"));
+	static const FName AutoRig(TEXT("AutoRig"));
+	static const FName TextureFetch(TEXT("TextureFetch"));
+	static const FName TextureWait(TEXT("TextureWait"));
+	static const FName Assemble(TEXT("Assemble"));
+	static const FName AssemblePipeline(TEXT("Assemble.Pipeline"));
+	static const FName AssembleBuild(TEXT("Assemble.Build"));
+	static const FName AssembleSave(TEXT("Assemble.Save"));
+	static const FName AssembleSaveFlush(TEXT("Assemble.SaveFlush"));
+	static const FName TeardownGC(TEXT("Teardown.GC"));
+	static const FName Total(TEXT("Total"));
+}
 
 void UEditorBatchGenerationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Initialized"));
 	// Register ticker delegate - this is how we "tick" in the editor!
+	// Ticks every frame so jobs advance as soon as their completion events arrive;
+	// the CheckInterval polling is handled as a watchdog inside TickStateMachine
 	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
 		FTickerDelegate::CreateUObject(this, &UEditorBatchGenerationSubsystem::TickStateMachine),
-		CheckIntervalConfig
+		0.0f
 	);
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Tick interval set to %.1f seconds"), CheckIntervalConfig);
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Watchdog interval set to %.1f seconds"), CheckIntervalConfig);
 }
 
 void UEditorBatchGenerationSubsystem::Deinitialize()
 {
 	// Stop any running generation
 	StopBatchGeneration();
+	UnbindCompletionEvents();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
 
 	Super::Deinitialize();
 	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Deinitialized"));
@@ -36,7 +72,30 @@ void UEditorBatchGenerationSubsystem::StartBatchGeneration(
 	FString OutputPath,
 	EMetaHumanQualityLevel QualityLevel,
 	float CheckInterval,
-	float LoopDelay)
+	float LoopDelay,
+	int32 MaxConcurrentJobs)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Batch generation already running!"));
+		return;
+	}
+
+	// Open-ended batch - entries are derived from a fresh seed as jobs are started
+	JobQueue.Reset();
+	ActiveManifest = FMetaHumanBatchManifest();
+	ActiveManifest.BatchSeed = static_cast<int32>(GetTypeHash(FDateTime::Now().GetTicks()));
+	CharacterLimitConfig = bLoopMode ? 0 : 1;
+
+	BeginBatch(bLoopMode, OutputPath, QualityLevel, CheckInterval, LoopDelay, MaxConcurrentJobs);
+}
+
+void UEditorBatchGenerationSubsystem::StartBatchGenerationFromManifest(
+	const FMetaHumanBatchManifest& Manifest,
+	FString OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	float CheckInterval,
+	int32 MaxConcurrentJobs)
 {
 	if (IsRunning())
 	{
@@ -44,10 +103,109 @@ void UEditorBatchGenerationSubsystem::StartBatchGeneration(
 		return;
 	}
 
+	if (Manifest.Entries.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Manifest has no entries, nothing to generate"));
+		return;
+	}
+
+	JobQueue.Reset();
+	ActiveManifest = Manifest;
+	CharacterLimitConfig = Manifest.Entries.Num();
+
+	BeginBatch(false, OutputPath, QualityLevel, CheckInterval, 0.0f, MaxConcurrentJobs);
+}
+
+void UEditorBatchGenerationSubsystem::StartSharedBatchGeneration(
+	const FMetaHumanBatchManifest& Manifest,
+	FString OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	float CheckInterval,
+	int32 MaxConcurrentJobs)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Batch generation already running!"));
+		return;
+	}
+
+	TSharedPtr<FMetaHumanBatchJobQueue> Queue = FMetaHumanBatchJobQueue::OpenOrCreate(Manifest);
+	if (!Queue.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Failed to open the job queue of batch %d"), Manifest.BatchSeed);
+		return;
+	}
+	Queue->SetLeaseDuration(LeaseDurationConfig);
+
+	JobQueue = Queue;
+	ActiveManifest = Queue->GetManifest();
+	CharacterLimitConfig = ActiveManifest.Entries.Num();
+	NextQueueClaimTime = 0.0;
+	bQueueComplete = false;
+	LeaseRenewTimer = 0.0f;
+
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Shared batch, worker %s (instance %s)"),
+		*Queue->GetWorkerId(), WorkerInstanceConfig.IsEmpty() ? FPlatformProcess::ComputerName() : *WorkerInstanceConfig);
+	BeginBatch(false, OutputPath, QualityLevel, CheckInterval, 0.0f, MaxConcurrentJobs);
+}
+
+void UEditorBatchGenerationSubsystem::SetLeaseTiming(float LeaseDuration, float RenewInterval)
+{
+	LeaseDurationConfig = FMath::Max(10.0f, LeaseDuration);
+	LeaseRenewIntervalConfig = FMath::Clamp(RenewInterval, 1.0f, LeaseDurationConfig * 0.5f);
+	if (JobQueue.IsValid())
+	{
+		JobQueue->SetLeaseDuration(LeaseDurationConfig);
+	}
+}
+
+void UEditorBatchGenerationSubsystem::StartSeededBatchGeneration(
+	int32 BatchSeed,
+	int32 Count,
+	FString OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	float CheckInterval,
+	int32 MaxConcurrentJobs)
+{
+	StartBatchGenerationFromManifest(
+		UMetaHumanBatchPlanner::PlanBatch(BatchSeed, Count),
+		OutputPath, QualityLevel, CheckInterval, MaxConcurrentJobs);
+}
+
+bool UEditorBatchGenerationSubsystem::StartBatchGenerationFromManifestFile(
+	const FString& ManifestFilePath,
+	FString OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	float CheckInterval,
+	int32 MaxConcurrentJobs)
+{
+	FMetaHumanBatchManifest Manifest;
+	if (!UMetaHumanBatchPlanner::LoadManifestFromFile(ManifestFilePath, Manifest))
+	{
+		return false;
+	}
+
+	StartBatchGenerationFromManifest(Manifest, OutputPath, QualityLevel, CheckInterval, MaxConcurrentJobs);
+	return true;
+}
+
+void UEditorBatchGenerationSubsystem::BeginBatch(
+	bool bLoopMode,
+	const FString& OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	float CheckInterval,
+	float LoopDelay,
+	int32 MaxConcurrentJobs)
+{
 	UE_LOG(LogTemp, Log, TEXT("=== EditorBatchGenerationSubsystem: Starting Batch Generation ==="));
 	UE_LOG(LogTemp, Log, TEXT("  Loop Mode: %s"), bLoopMode ? TEXT("Enabled") : TEXT("Disabled"));
 	UE_LOG(LogTemp, Log, TEXT("  Output Path: %s"), *OutputPath);
-	UE_LOG(LogTemp, Log, TEXT("  Check Interval: %.1f seconds"), CheckInterval);
+	UE_LOG(LogTemp, Log, TEXT("  Watchdog Interval: %.1f seconds"), CheckInterval);
+	UE_LOG(LogTemp, Log, TEXT("  Max Concurrent Jobs: %d"), MaxConcurrentJobs);
+	UE_LOG(LogTemp, Log, TEXT("  Variants Per Rig: %d"), VariantsPerRigConfig);
+	UE_LOG(LogTemp, Log, TEXT("  Batch Seed: %d"), ActiveManifest.BatchSeed);
+	UE_LOG(LogTemp, Log, TEXT("  Planned Characters: %s"),
+		CharacterLimitConfig > 0 ? *FString::FromInt(CharacterLimitConfig) : TEXT("Unlimited"));
 
 	// Store configuration
 	bLoopGenerationEnabled = bLoopMode;
@@ -55,50 +213,148 @@ void UEditorBatchGenerationSubsystem::StartBatchGeneration(
 	QualityLevelConfig = QualityLevel;
 	CheckIntervalConfig = CheckInterval;
 	LoopDelayConfig = LoopDelay;
+	MaxConcurrentJobsConfig = FMath::Max(1, MaxConcurrentJobs);
+	BatchQualityLevels.Reset();
+	BatchQualityLevels.Add(QualityLevel);
+	for (const EMetaHumanQualityLevel ExtraQualityLevel : ExtraQualityLevelsConfig)
+	{
+		BatchQualityLevels.AddUnique(ExtraQualityLevel);
+	}
+	for (const EMetaHumanQualityLevel BatchQualityLevel : BatchQualityLevels)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Quality Level: %s"), *UEnum::GetValueAsString(BatchQualityLevel));
+	}
+	BatchTextureResolution = UMetaHumanParametricGenerator::ResolveTextureResolution(TextureResolutionConfig, BatchQualityLevels);
+	UE_LOG(LogTemp, Log, TEXT("  Texture Resolution: %s"), *UEnum::GetValueAsString(BatchTextureResolution));
 
 	// Reset state
+	Jobs.Reset();
+	StartedCount = 0;
 	GeneratedCount = 0;
-	LastErrorMessage.Empty();
+	FailedCount = 0;
+	Metrics.Reset();
+	MetricsDumpTimer = 0.0f;
+	DeadLetters.Reset();
+
+	// Baseline of the per-job memory deltas
+	JobsSinceCollection = 0;
+	LastCollectionUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	Metrics.RecordMemory(LastCollectionUsedPhysical);
+
+	// Stream the whole wardrobe catalog in while the first characters authenticate and configure
+	bWardrobePreloadRecorded = false;
+	if (bPreloadWardrobeConfig)
+	{
+		TArray<FString> WardrobeItemPaths;
+		UMetaHumanBatchPlanner::GetWardrobeCatalog(WardrobeItemPaths);
+		if (!WardrobePreloader.IsValid())
+		{
+			WardrobePreloader = MakeShared<FMetaHumanWardrobePreloader>();
+		}
+		WardrobePreloader->Preload(WardrobeItemPaths);
+	}
 
-	// Start state machine
-	TransitionToState(EBatchGenState::Preparing);
+	// Listen for rig completion before any AutoRig is started
+	BindCompletionEvents();
+	WatchdogTimer = 0.0f;
+
+	// Start scheduler - the first jobs are created right away, the rest on the next ticks
+	bBatchRunning = true;
+	ScheduleJobs();
 }
 
 void UEditorBatchGenerationSubsystem::StopBatchGeneration()
 {
-	if (!IsRunning() && CurrentState != EBatchGenState::Error)
+	if (!IsRunning())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No batch generation running"));
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Stopping batch generation"));
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Stopping batch generation (%d job(s) in flight)"), Jobs.Num());
+	DumpMetrics();
+
+	for (FBatchGenerationJob& Job : Jobs)
+	{
+		// Assembled already - only its writes are outstanding, so finish it instead of giving it up
+		if (Job.State == EBatchGenState::Saving)
+		{
+			FinishSaving(Job);
+		}
+		// Hand unfinished entries back so other workers do not have to wait for the leases to expire
+		else if (JobQueue.IsValid())
+		{
+			JobQueue->ReleaseLease(Job.ManifestEntry.Index);
+		}
+
+		// The table is dropped below, so no state handler will tear these jobs down
+		ReleaseJobCharacter(Job);
+	}
+	CollectGarbageIfDue(true);
 
 	// Reset state
-	TransitionToState(EBatchGenState::Idle);
-	GeneratedCharacter.Reset();
-	CurrentCharacterName.Empty();
+	Jobs.Reset();
+	bBatchRunning = false;
+	UnbindCompletionEvents();
+	ReleaseWardrobePreload();
 }
 
-FString UEditorBatchGenerationSubsystem::GetCurrentStateString() const
+FString UEditorBatchGenerationSubsystem::GetStateDisplayString(EBatchGenState State)
 {
-	switch (CurrentState)
+	switch (State)
 	{
 		case EBatchGenState::Idle: return TEXT("Idle");
 		case EBatchGenState::Preparing: return TEXT("Preparing Character");
-		case EBatchGenState::WaitingForRig: return TEXT("Waiting for AutoRig");
+		case EBatchGenState::WaitingForRig: return TEXT("Waiting for AutoRig/Textures");
 		case EBatchGenState::Assembling: return TEXT("Assembling Character");
+		case EBatchGenState::Saving: return TEXT("Writing Assembled Packages");
 		case EBatchGenState::Complete: return TEXT("Complete");
 		case EBatchGenState::Error: return TEXT("Error");
+		case EBatchGenState::Backoff: return TEXT("Waiting to Retry");
 		default: return TEXT("Unknown");
 	}
 }
 
-void UEditorBatchGenerationSubsystem::GetStatusInfo(EBatchGenState& OutState, FString& OutCharacterName, int32& OutGeneratedCount) const
+FString UEditorBatchGenerationSubsystem::GetCurrentStateString() const
+{
+	if (!IsRunning())
+	{
+		return GetStateDisplayString(EBatchGenState::Idle);
+	}
+
+	if (Jobs.Num() == 0)
+	{
+		return TEXT("Running (no jobs in flight)");
+	}
+
+	// Summarize as "Running: 2x Waiting for AutoRig, 1x Preparing Character"
+	TMap<EBatchGenState, int32> StateCounts;
+	for (const FBatchGenerationJob& Job : Jobs)
+	{
+		StateCounts.FindOrAdd(Job.State)++;
+	}
+
+	TArray<FString> Parts;
+	for (const TPair<EBatchGenState, int32>& Pair : StateCounts)
+	{
+		Parts.Add(FString::Printf(TEXT("%dx %s"), Pair.Value, *GetStateDisplayString(Pair.Key)));
+	}
+	return FString::Printf(TEXT("Running: %s"), *FString::Join(Parts, TEXT(", ")));
+}
+
+void UEditorBatchGenerationSubsystem::GetStatusInfo(EBatchGenState& OutState, FString& OutCharacterName, int32& OutGeneratedCount, FMetaHumanBatchMetricsSnapshot& OutMetrics) const
 {
-	OutState = CurrentState;
-	OutCharacterName = CurrentCharacterName;
+	OutState = EBatchGenState::Idle;
+	OutCharacterName.Empty();
 	OutGeneratedCount = GeneratedCount;
+	OutMetrics = Metrics.GetSnapshot();
+
+	// Jobs are appended in start order, so the first one is the oldest
+	if (Jobs.Num() > 0)
+	{
+		OutState = Jobs[0].State;
+		OutCharacterName = Jobs[0].CharacterName;
+	}
 }
 
 // ============================================================================
@@ -110,47 +366,66 @@ bool UEditorBatchGenerationSubsystem::TickStateMachine(float DeltaTime)
 	// This function is called by FTSTicker periodically
 	// It's the equivalent of Tick() but works in the editor!
 
-	if (bShouldProcessState)
+	// Watchdog - re-check waiting jobs every CheckInterval in case an event was missed
+	WatchdogTimer += DeltaTime;
+	const bool bWatchdogPoll = WatchdogTimer >= CheckIntervalConfig;
+	if (bWatchdogPoll)
 	{
+		WatchdogTimer = 0.0f;
+	}
 
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Tick, current state: %s)"), *GetCurrentStateString());
-		switch (CurrentState)
+	if (IsRunning())
+	{
+		if (bWatchdogPoll)
 		{
-			case EBatchGenState::Idle:
-				HandleIdleState();
-				break;
-			case EBatchGenState::Preparing:
-				HandlePreparingState();
-				break;
-			case EBatchGenState::WaitingForRig:
-				HandleWaitingForRigState();
-				break;
-			case EBatchGenState::Assembling:
-				HandleAssemblingState();
-				break;
-			case EBatchGenState::Complete:
-				HandleCompleteState();
-				break;
-			case EBatchGenState::Error:
-				HandleErrorState();
-				break;
+			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Tick, %s"), *GetCurrentStateString());
 		}
-	}
 
-	// Handle loop delay timer
-	if (CurrentState == EBatchGenState::Complete && bLoopGenerationEnabled && LoopDelayTimer > 0.0f)
-	{
-		LoopDelayTimer -= DeltaTime;
-		if (LoopDelayTimer <= 0.0f)
+		UpdateWardrobePreload();
+
+		// Preparation is spread over frames - all Preparing jobs share this tick's budget
+		PrepareBudgetDeadline = FPlatformTime::Seconds() + PrepareBudgetMsConfig / 1000.0;
+		bPrepareStepRunThisTick = false;
+
+		// Advance every job's own state machine, starting one job further each tick
+		const int32 NumJobs = Jobs.Num();
+		for (int32 Offset = 0; Offset < NumJobs; ++Offset)
 		{
-			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Loop delay finished, starting new generation"));
-			TransitionToState(EBatchGenState::Preparing);
+			ProcessJob(Jobs[(FirstJobToProcess + Offset) % NumJobs], DeltaTime, bWatchdogPoll);
+		}
+		FirstJobToProcess = NumJobs > 0 ? (FirstJobToProcess + 1) % NumJobs : 0;
+
+		// Keep the queue leases of running jobs alive
+		if (JobQueue.IsValid())
+		{
+			LeaseRenewTimer += DeltaTime;
+			if (LeaseRenewTimer >= LeaseRenewIntervalConfig)
+			{
+				LeaseRenewTimer = 0.0f;
+				for (FBatchGenerationJob& Job : Jobs)
+				{
+					if (Job.State != EBatchGenState::Idle)
+					{
+						RenewJobLease(Job);
+					}
+				}
+			}
+		}
+
+		// Retire finished jobs and hand their slots to new characters
+		ScheduleJobs();
+
+		MetricsDumpTimer += DeltaTime;
+		if (MetricsDumpTimer >= MetricsDumpIntervalConfig)
+		{
+			MetricsDumpTimer = 0.0f;
+			DumpMetrics();
 		}
 	}
 
-	if (bAutoStartGeneration)
+	if (bAutoStartGeneration && bWatchdogPoll)
 	{
-		if (CurrentState == EBatchGenState::Idle) 
+		if (!IsRunning())
 		{
 			// add async task GameThread
 			AsyncTask(ENamedThreads::GameThread, [this]()
@@ -164,10 +439,6 @@ bool UEditorBatchGenerationSubsystem::TickStateMachine(float DeltaTime)
 				);
 			});
 		}
-		if (CurrentState == EBatchGenState::Error)
-		{
-			StopBatchGeneration();
-		}
 	}
 	
 
@@ -175,551 +446,1033 @@ bool UEditorBatchGenerationSubsystem::TickStateMachine(float DeltaTime)
 	return true;
 }
 
-void UEditorBatchGenerationSubsystem::TransitionToState(EBatchGenState NewState)
+void UEditorBatchGenerationSubsystem::ProcessJob(FBatchGenerationJob& Job, float DeltaTime, bool bWatchdogPoll)
 {
-	if (CurrentState == NewState)
-		return;
+	const bool bStateEntered = Job.bShouldProcessState;
+	Job.bShouldProcessState = false;
+
+	switch (Job.State)
+	{
+		case EBatchGenState::Idle:
+			// Slot is free, ScheduleJobs() will remove it
+			break;
+		case EBatchGenState::Preparing:
+			HandlePreparingState(Job, bStateEntered);
+			break;
+		case EBatchGenState::WaitingForRig:
+			if (ShouldProcessWaitingJob(Job, bStateEntered, bWatchdogPoll))
+			{
+				Job.bRigStateChanged = false;
+				HandleWaitingForRigState(Job);
+			}
+			break;
+		case EBatchGenState::Assembling:
+			// The lease is kept alive by the renewal timer in TickStateMachine
+			HandleAssemblingState(Job);
+			break;
+		case EBatchGenState::Saving:
+			HandleSavingState(Job);
+			break;
+		case EBatchGenState::Complete:
+			HandleCompleteState(Job, bStateEntered, DeltaTime);
+			break;
+		case EBatchGenState::Error:
+			HandleErrorState(Job);
+			break;
+		case EBatchGenState::Backoff:
+			HandleBackoffState(Job, DeltaTime);
+			break;
+	}
+}
+
+bool UEditorBatchGenerationSubsystem::ShouldProcessWaitingJob(const FBatchGenerationJob& Job, bool bStateEntered, bool bWatchdogPoll) const
+{
+	if (bStateEntered || bWatchdogPoll || Job.bRigStateChanged)
+	{
+		return true;
+	}
+
+	// The editor subsystem has no completion event for texture requests, but the typed
+	// query is a cheap lookup, so check it every frame while the fetch runs
+	if (Job.TextureTask == EBatchGenTaskState::Running && Job.Character.IsValid())
+	{
+		UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>();
+		return EditorSubsystem && !EditorSubsystem->IsRequestingHighResolutionTextures(Job.Character.Get());
+	}
+
+	if (Job.TextureTask == EBatchGenTaskState::Failed && Job.TextureRetryTime > 0.0)
+	{
+		return FPlatformTime::Seconds() >= Job.TextureRetryTime;
+	}
+
+	return false;
+}
+
+void UEditorBatchGenerationSubsystem::ScheduleJobs()
+{
+	// Jobs that went back to Idle have released their slot
+	Jobs.RemoveAll([](const FBatchGenerationJob& Job)
+	{
+		return Job.State == EBatchGenState::Idle;
+	});
+	CollectGarbageIfDue(false);
+
+	while (GetNumJobsInSlots() < MaxConcurrentJobsConfig && CanStartNewJob())
+	{
+		FMetaHumanBatchManifestEntry Entry;
+		if (!TryGetNextManifestEntry(Entry))
+		{
+			break;
+		}
+
+		FBatchGenerationJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.JobId = NextJobId++;
+		Job.ManifestEntry = Entry;
+		Job.JobStartTime = FPlatformTime::Seconds();
+		StartedCount++;
 
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: State transition: %s -> %s"),
-		*GetCurrentStateString(), *UEnum::GetValueAsString(NewState));
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Starting job %d (%d/%d slots in use)"),
+			Job.JobId, GetNumJobsInSlots(), MaxConcurrentJobsConfig);
+		TransitionToState(Job, EBatchGenState::Preparing);
+	}
 
-	CurrentState = NewState;
-	bShouldProcessState = true; // Process immediately on state change
+	if (Jobs.Num() == 0 && !CanStartNewJob())
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Batch finished: %d generated, %d failed ==="),
+			GeneratedCount, FailedCount);
+		bBatchRunning = false;
+		CollectGarbageIfDue(true);
+		DumpMetrics();
+		UnbindCompletionEvents();
+		ReleaseWardrobePreload();
+	}
 }
 
-void UEditorBatchGenerationSubsystem::HandleIdleState()
+bool UEditorBatchGenerationSubsystem::CanStartNewJob() const
 {
-	// Nothing to do in idle state
+	// Shared batches run until every entry is done by some worker
+	if (JobQueue.IsValid())
+	{
+		return !bQueueComplete;
+	}
+	return CharacterLimitConfig <= 0 || StartedCount < CharacterLimitConfig;
 }
 
-void UEditorBatchGenerationSubsystem::HandlePreparingState()
+bool UEditorBatchGenerationSubsystem::TryGetNextManifestEntry(FMetaHumanBatchManifestEntry& OutEntry)
 {
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Starting Character Preparation ==="));
+	if (JobQueue.IsValid())
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now < NextQueueClaimTime)
+		{
+			return false;
+		}
 
-	FMetaHumanBodyParametricConfig BodyConfig;
-	FMetaHumanAppearanceConfig AppearanceConfig;
-	GenerateRandomCharacterConfigs(BodyConfig, AppearanceConfig, CurrentCharacterName);
+		if (JobQueue->TryClaimNext(OutEntry))
+		{
+			return true;
+		}
 
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Character Name: %s"), *CurrentCharacterName);
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Body Type: %s"), *UEnum::GetValueAsString(BodyConfig.BodyType));
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Output Path: %s"), *OutputPathConfig);
+		// Everything left is leased by other workers - look again later, in case one of them dies
+		NextQueueClaimTime = Now + CheckIntervalConfig;
+		bQueueComplete = JobQueue->IsComplete();
+		return false;
+	}
 
-	UMetaHumanCharacter* Character = nullptr;
-	bool bSuccess = UMetaHumanParametricGenerator::PrepareAndRigCharacter(
-		CurrentCharacterName,
-		OutputPathConfig,
-		BodyConfig,
-		AppearanceConfig,
-		Character
-	);
+	if (ActiveManifest.Entries.IsValidIndex(StartedCount))
+	{
+		OutEntry = ActiveManifest.Entries[StartedCount];
+		return true;
+	}
+
+	OutEntry.Index = StartedCount;
+	OutEntry.Seed = UMetaHumanBatchPlanner::GetEntrySeed(ActiveManifest.BatchSeed, StartedCount);
+	return true;
+}
 
-	if (bSuccess && Character)
+bool UEditorBatchGenerationSubsystem::RenewJobLease(FBatchGenerationJob& Job)
+{
+	if (!JobQueue.IsValid() || JobQueue->RenewLease(Job.ManifestEntry.Index))
 	{
-		GeneratedCharacter = Character;
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ Preparation complete, AutoRig started"));
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Transitioning to WaitingForRig state"));
-		UMetaHumanParametricGenerator::DownloadTextureSourceData(Character);
-		TransitionToState(EBatchGenState::WaitingForRig);
+		return true;
 	}
-	else
+
+	// Another worker owns the entry now and will generate it - drop ours without counting it as a failure
+	UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d lost its lease on entry %d, abandoning it"),
+		Job.JobId, Job.ManifestEntry.Index);
+	Metrics.IncrementCounter(TEXT("Queue.LeasesLost"));
+	ReleaseJobCharacter(Job);
+	TransitionToState(Job, EBatchGenState::Idle);
+	return false;
+}
+
+FString UEditorBatchGenerationSubsystem::GetBatchFileTag() const
+{
+	if (JobQueue.IsValid())
 	{
-		LastErrorMessage = TEXT("Failed to prepare character or start AutoRig");
-		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ %s"), *LastErrorMessage);
-		TransitionToState(EBatchGenState::Error);
+		return FString::Printf(TEXT("%d_%s"), ActiveManifest.BatchSeed, *JobQueue->GetWorkerId());
 	}
+	return FString::FromInt(ActiveManifest.BatchSeed);
 }
 
-void UEditorBatchGenerationSubsystem::HandleWaitingForRigState()
+void UEditorBatchGenerationSubsystem::TransitionToState(FBatchGenerationJob& Job, EBatchGenState NewState)
 {
-	if (!GeneratedCharacter.IsValid())
+	if (Job.State == NewState)
+		return;
+
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d state transition: %s -> %s"),
+		Job.JobId, *GetStateDisplayString(Job.State), *GetStateDisplayString(NewState));
+
+	Job.State = NewState;
+	Job.StageStartTime = FPlatformTime::Seconds();
+	if (NewState == EBatchGenState::WaitingForRig)
+	{
+		Job.StageDeadline = Job.StageStartTime + RigTimeoutConfig;
+	}
+	else if (NewState == EBatchGenState::Saving)
 	{
-		LastErrorMessage = TEXT("Character reference lost while waiting for rig");
-		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ %s"), *LastErrorMessage);
-		TransitionToState(EBatchGenState::Error);
+		Job.StageDeadline = Job.StageStartTime + SaveFlushTimeoutConfig;
+	}
+	Job.bShouldProcessState = true; // Run the entry logic of the new state on the next tick
+}
+
+void UEditorBatchGenerationSubsystem::EndStage(FBatchGenerationJob& Job, FName Stage, bool bSuccess)
+{
+	const double Now = FPlatformTime::Seconds();
+	Metrics.RecordStage(Stage, Now - Job.StageStartTime, bSuccess);
+	Job.StageStartTime = Now;
+}
+
+void UEditorBatchGenerationSubsystem::DumpMetrics() const
+{
+	const FString FilePath = FPaths::Combine(
+		FMetaHumanBatchMetrics::GetDefaultMetricsDirectory(),
+		FString::Printf(TEXT("BatchMetrics_%s.json"), *GetBatchFileTag()));
+
+	if (Metrics.WriteToFile(FilePath))
+	{
+		const FMetaHumanBatchMetricsSnapshot Snapshot = Metrics.GetSnapshot();
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Metrics - %d done, %d failed, %.1f characters/hour -> %s"),
+			Snapshot.CharactersCompleted, Snapshot.CharactersFailed, Snapshot.CharactersPerHour, *FilePath);
+	}
+}
+
+bool UEditorBatchGenerationSubsystem::IsWardrobePreloadComplete() const
+{
+	return !WardrobePreloader.IsValid() || !WardrobePreloader->IsActive() || WardrobePreloader->IsComplete();
+}
+
+void UEditorBatchGenerationSubsystem::UpdateWardrobePreload()
+{
+	if (bWardrobePreloadRecorded || !WardrobePreloader.IsValid() || !WardrobePreloader->IsActive() || !WardrobePreloader->IsComplete())
 		return;
+
+	bWardrobePreloadRecorded = true;
+	const int32 NumLoaded = WardrobePreloader->GetNumLoaded();
+	const int32 NumRequested = WardrobePreloader->GetNumRequested();
+	Metrics.RecordStage(BatchGenStage::WardrobePreload, WardrobePreloader->GetLoadSeconds(), NumLoaded == NumRequested);
+
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Wardrobe preloaded, %d/%d item(s) in %.2fs"),
+		NumLoaded, NumRequested, WardrobePreloader->GetLoadSeconds());
+	if (NumLoaded < NumRequested)
+	{
+		WardrobePreloader->LogMissingItems();
+	}
+}
+
+void UEditorBatchGenerationSubsystem::ReleaseWardrobePreload()
+{
+	if (WardrobePreloader.IsValid())
+	{
+		WardrobePreloader->Release();
 	}
+}
+
+void UEditorBatchGenerationSubsystem::HandlePreparingState(FBatchGenerationJob& Job, bool bStateEntered)
+{
+	FMetaHumanPrepareContext& Context = Job.PrepareContext;
 
-	// Check rigging status
-	FString RigStatus = UMetaHumanParametricGenerator::GetRiggingStatusString(GeneratedCharacter.Get());
+	if (bStateEntered)
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Job %d: Starting Character Preparation ==="), Job.JobId);
 
-	// Log status periodically
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Checking rig status... %s"), *RigStatus);
+		Context = FMetaHumanPrepareContext();
+		UMetaHumanBatchPlanner::ExpandEntry(Job.ManifestEntry, QualityLevelConfig, Context.BodyConfig, Context.AppearanceConfig, Job.CharacterName);
 
-	// Check if rigged
-	if (RigStatus.Contains(TEXT("Rigged")))
+		// A full retry must not collide with the asset left behind by the failed attempt
+		if (Job.RetryCount > 0)
+		{
+			Job.CharacterName += FString::Printf(TEXT("_R%d"), Job.RetryCount);
+		}
+		Context.CharacterName = Job.CharacterName;
+		Context.OutputPath = OutputPathConfig;
+		Context.bUseRigCache = bUseRigCacheConfig;
+		Context.bBuildPreview = bBuildPreviewConfig;
+		Context.bUseCharacterPrototype = bUseCharacterPrototypeConfig;
+		Context.TextureResolution = BatchTextureResolution;
+		Job.VariantIndex = 0;
+		Job.RigTask = EBatchGenTaskState::NotStarted;
+		Job.TextureTask = EBatchGenTaskState::NotStarted;
+		Job.TextureRetryCount = 0;
+		Job.TextureRetryTime = 0.0;
+		Job.bTexturesFromCache = false;
+
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Character Name: %s (entry %d, seed %d)"),
+			*Job.CharacterName, Job.ManifestEntry.Index, Job.ManifestEntry.Seed);
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Body Type: %s"), *UEnum::GetValueAsString(Context.BodyConfig.BodyType));
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Output Path: %s"), *OutputPathConfig);
+	}
+
+	// Run steps until the tick's budget is spent; the first step of a tick always runs so preparation keeps moving
+	while (!Context.IsDone())
 	{
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ AutoRig complete!"));
+		if (bPrepareStepRunThisTick && FPlatformTime::Seconds() >= PrepareBudgetDeadline)
+			return;
 
-		UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>();
-		if (!EditorSubsystem)
+		// Wardrobe steps wait for the preload instead of loading the items synchronously
+		if (Context.Step == EMetaHumanPrepareStep::AddHair && !IsWardrobePreloadComplete())
+			return;
+		bPrepareStepRunThisTick = true;
+
+		if (!UMetaHumanParametricGenerator::RunPrepareStep(Context))
 		{
-			UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Failed to get MetaHumanCharacterEditorSubsystem"));
-			LastErrorMessage = TEXT("Failed to get MetaHumanCharacterEditorSubsystem");
-			TransitionToState(EBatchGenState::Error);
+			EndStage(Job, BatchGenStage::Prepare, false);
+			FailJob(Job,
+				Context.Failure != EMetaHumanGenerationFailure::None ? Context.Failure : EMetaHumanGenerationFailure::Create,
+				FString::Printf(TEXT("Failed to prepare character or start AutoRig (step %s)"), *UEnum::GetDisplayValueAsText(Context.Step).ToString()));
+			return;
 		}
-		if (!EditorSubsystem->IsRequestingHighResolutionTextures(GeneratedCharacter.Get()))
+
+		// Textures only need the committed skin - start them now so they download during the rest of preparation and AutoRig
+		if (Job.TextureTask == EBatchGenTaskState::NotStarted && Context.Character && Context.Step > EMetaHumanPrepareStep::ConfigureAppearance)
 		{
-			TransitionToState(EBatchGenState::Assembling);
+			StartTextureFetch(Job, Context.Character, false);
+		}
+
+		// Waiting on the login check - try again next tick instead of spinning
+		if (Context.bWaiting)
+			return;
+	}
+
+	UMetaHumanCharacter* Character = Context.Character;
+	EndStage(Job, BatchGenStage::Prepare, Character != nullptr);
+
+	if (Character)
+	{
+		Job.Character = Character;
+		if (Context.bUseRigCache)
+		{
+			Metrics.IncrementCounter(Context.bRigCacheHit ? TEXT("RigCache.Hits") : TEXT("RigCache.Misses"));
+		}
+		// The one-off prototype initialization is kept out of the per-character creation time
+		Metrics.RecordStage(BatchGenStage::PrepareCreateCharacter, Context.CreateCharacterSeconds - Context.PrototypeInitSeconds, true);
+		if (Context.PrototypeInitSeconds > 0.0f)
+		{
+			Metrics.RecordStage(BatchGenStage::PreparePrototypeInit, Context.PrototypeInitSeconds, true);
+		}
+		if (Context.PreviewBuildSeconds > 0.0f)
+		{
+			Metrics.RecordStage(BatchGenStage::PreparePreviewBuild, Context.PreviewBuildSeconds, true);
 		}
 		else
 		{
-			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ AutoRig complete! Downloading Texture."));
+			Metrics.IncrementCounter(TEXT("PreviewBuild.Skipped"));
 		}
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ Preparation complete, %s"),
+			Context.bRigCacheHit ? TEXT("rig restored from cache") : TEXT("AutoRig started"));
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Transitioning to WaitingForRig state"));
+		Job.RigTask = EBatchGenTaskState::Running;
+		if (Job.TextureTask == EBatchGenTaskState::NotStarted)
+		{
+			StartTextureFetch(Job, Character, true);
+		}
+		TransitionToState(Job, EBatchGenState::WaitingForRig);
 	}
-	else if (RigStatus.Contains(TEXT("Unrigged")) && !RigStatus.Contains(TEXT("RigPending")))
+	else
 	{
-		// If it went back to Unrigged (not RigPending), that means it failed
-		LastErrorMessage = TEXT("AutoRig failed - character is unrigged");
-		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ %s"), *LastErrorMessage);
-		TransitionToState(EBatchGenState::Error);
+		FailJob(Job, EMetaHumanGenerationFailure::Create, TEXT("Failed to prepare character or start AutoRig"));
 	}
-	// Otherwise, still waiting (RigPending) - will check again on next tick
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: AutoRig is still pending... %s"), *RigStatus);
 }
 
-void UEditorBatchGenerationSubsystem::HandleAssemblingState()
+void UEditorBatchGenerationSubsystem::HandleWaitingForRigState(FBatchGenerationJob& Job)
 {
-	if (!GeneratedCharacter.IsValid())
+	if (!Job.Character.IsValid())
+	{
+		EndStage(Job, Job.RigTask == EBatchGenTaskState::Done ? BatchGenStage::TextureWait : BatchGenStage::AutoRig, false);
+		FailJob(Job, EMetaHumanGenerationFailure::Rig, TEXT("Character reference lost while waiting for rig"));
+		return;
+	}
+
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>();
+	if (!EditorSubsystem)
 	{
-		LastErrorMessage = TEXT("Character reference lost during assembly");
-		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ %s"), *LastErrorMessage);
-		TransitionToState(EBatchGenState::Error);
+		FailJob(Job, EMetaHumanGenerationFailure::Rig, TEXT("Failed to get MetaHumanCharacterEditorSubsystem"));
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Starting Character Assembly ==="));
+	// AutoRig and the texture fetch run side by side - each is advanced on its own
+	if (Job.RigTask == EBatchGenTaskState::Running)
+	{
+		switch (EditorSubsystem->GetRiggingState(Job.Character.Get()))
+		{
+			case EMetaHumanCharacterRigState::Rigged:
+				EndStage(Job, BatchGenStage::AutoRig, true);
+				Job.RigTask = EBatchGenTaskState::Done;
+				Job.RigDoneTime = FPlatformTime::Seconds();
+				if (Job.PrepareContext.bUseRigCache && !Job.PrepareContext.bRigCacheHit)
+				{
+					FMetaHumanRigCache::Store(Job.Character.Get(), Job.PrepareContext.RigCacheKey);
+				}
+				UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ Job %d: AutoRig complete (textures: %s)"),
+					Job.JobId, *UEnum::GetDisplayValueAsText(Job.TextureTask).ToString());
+				break;
 
-	// Call Step 2: Assemble
-	bool bSuccess = UMetaHumanParametricGenerator::AssembleCharacter(
-		GeneratedCharacter.Get(),
-		OutputPathConfig,
-		QualityLevelConfig
-	);
+			case EMetaHumanCharacterRigState::Unrigged:
+				// If it went back to Unrigged (not RigPending), that means it failed
+				EndStage(Job, BatchGenStage::AutoRig, false);
+				Job.RigTask = EBatchGenTaskState::Failed;
+				FailJob(Job, EMetaHumanGenerationFailure::Rig, TEXT("AutoRig failed - character is unrigged"));
+				return;
+
+			case EMetaHumanCharacterRigState::RigPending:
+				// Still waiting - the rig event or the watchdog will run this again, unless the deadline has passed
+				if (FPlatformTime::Seconds() >= Job.StageDeadline)
+				{
+					EndStage(Job, BatchGenStage::AutoRig, false);
+					Job.RigTask = EBatchGenTaskState::Failed;
+					FailJob(Job, EMetaHumanGenerationFailure::Rig,
+						FString::Printf(TEXT("AutoRig timed out after %.0f seconds"), RigTimeoutConfig));
+					return;
+				}
+				UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: AutoRig pending..."), Job.JobId);
+				break;
+		}
+	}
 
-	if (bSuccess)
+	UpdateTextureFetch(Job, EditorSubsystem);
+	if (Job.TextureTask == EBatchGenTaskState::Failed && Job.TextureRetryTime <= 0.0)
 	{
-		GeneratedCount++;
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓✓✓ Character generation complete! ✓✓✓"));
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Character '%s' saved to %s"), *CurrentCharacterName, *OutputPathConfig);
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Total characters generated: %d"), GeneratedCount);
-		TransitionToState(EBatchGenState::Complete);
+		FailJob(Job, EMetaHumanGenerationFailure::Texture,
+			FString::Printf(TEXT("Texture fetch failed after %d retries"), Job.TextureRetryCount));
+		return;
 	}
-	else
+
+	if (Job.RigTask == EBatchGenTaskState::Done && Job.TextureTask == EBatchGenTaskState::Done)
 	{
-		LastErrorMessage = TEXT("Failed to assemble character");
-		UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ %s"), *LastErrorMessage);
-		TransitionToState(EBatchGenState::Error);
+		// Only the part of the texture fetch that outlived the rig held the job up
+		Metrics.RecordStage(BatchGenStage::TextureWait, FPlatformTime::Seconds() - Job.RigDoneTime, true);
+
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ Job %d: AutoRig and textures ready"), Job.JobId);
+		TransitionToState(Job, EBatchGenState::Assembling);
 	}
 }
 
-void UEditorBatchGenerationSubsystem::HandleCompleteState()
+// ============================================================================
+// Texture Fetch
+// ============================================================================
+
+void UEditorBatchGenerationSubsystem::StartTextureFetch(FBatchGenerationJob& Job, UMetaHumanCharacter* Character, bool bFinalAttempt)
 {
-	// Log completion (only once per character generation)
-	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Generation Complete ==="));
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>();
+	if (!Character || !EditorSubsystem)
+	{
+		return;
+	}
 
-	if (bLoopGenerationEnabled)
+	// The quality level does not use high-resolution textures - the synthesized ones are assembled as they are
+	if (BatchTextureResolution == EMetaHumanTextureResolution::None)
 	{
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Loop mode enabled - will start next character in %.1f seconds"), LoopDelayConfig);
-		LoopDelayTimer = LoopDelayConfig;
+		Job.TextureTask = EBatchGenTaskState::Done;
+		Metrics.IncrementCounter(TEXT("TextureFetch.Disabled"));
+		return;
 	}
-}
 
-void UEditorBatchGenerationSubsystem::HandleErrorState()
-{
-	// Log error state
-	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: === Error State ==="));
-	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Error: %s"), *LastErrorMessage);
-	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Call StopBatchGeneration() or StartBatchGeneration() to retry"));
-}
+	// Before the end of preparation only start once the synthesized textures exist, so the request cannot be refused
+	const bool bCanRequest = EditorSubsystem->IsTextureSynthesisEnabled() && Character->HasSynthesizedTextures();
+	if (!bFinalAttempt && !bCanRequest)
+	{
+		return;
+	}
 
-// ============================================================================
-// Random Parameter Generation
-// ============================================================================
+	const double Now = FPlatformTime::Seconds();
+	Job.TextureStartTime = Now;
 
-void UEditorBatchGenerationSubsystem::GenerateRandomCharacterConfigs(
-	FMetaHumanBodyParametricConfig& OutBodyConfig,
-	FMetaHumanAppearanceConfig& OutAppearanceConfig,
-	FString& OutCharacterName)
-{
-	auto RandomChoice = [](const TArray<FString>& Array) -> FString
+	if (Character->HasHighResolutionTextures())
 	{
-		if (Array.Num() == 0)
+		Job.TextureTask = EBatchGenTaskState::Done;
+		Metrics.RecordStage(BatchGenStage::TextureFetch, 0.0, true);
+		return;
+	}
+
+	// Face and body textures seen before are served from disk
+	if (bUseTextureCacheConfig)
+	{
+		Job.bTexturesFromCache = FMetaHumanTextureCache::TryApply(Character, UMetaHumanParametricGenerator::GetTextureResolutionSize(BatchTextureResolution));
+		Metrics.IncrementCounter(Job.bTexturesFromCache ? TEXT("TextureCache.Hits") : TEXT("TextureCache.Misses"));
+		if (Job.bTexturesFromCache)
 		{
-			UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: RandomChoice: Array is empty"));
-			return FString("");
+			Job.TextureTask = EBatchGenTaskState::Done;
+			Metrics.RecordStage(BatchGenStage::TextureFetch, FPlatformTime::Seconds() - Now, true);
+			return;
 		}
-		int32 index = FMath::RandRange(0, Array.Num() - 1);
-		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: RandomChoice: Selected %s from Array"), *Array[index]);
-		return Array[index];
-	};
-	int32 RandomBodyTypeIndex = FMath::RandRange(0, 17);
-	OutBodyConfig.BodyType = static_cast<EMetaHumanBodyType>(RandomBodyTypeIndex);
-	// OutBodyConfig.BodyType = EMetaHumanBodyType::BlendableBody;
-
-	OutBodyConfig.GlobalDeltaScale = 1.0f;
-	OutBodyConfig.bUseParametricBody = true;
-	OutBodyConfig.BodyMeasurements.Empty();
+	}
 
-	float MasculineFeminine = FMath::FRandRange(-1.5f, 1.5f);
-	bool bIsFemale = true;
-	if (MasculineFeminine < 0.0f) 
+	if (UMetaHumanParametricGenerator::DownloadTextureSourceData(Character, BatchTextureResolution) || EditorSubsystem->IsRequestingHighResolutionTextures(Character))
 	{
-		bIsFemale = false;
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Texture fetch started"), Job.JobId);
+		Job.TextureTask = EBatchGenTaskState::Running;
+		Job.TextureDeadline = Now + TextureTimeoutConfig;
+		return;
 	}
-	OutBodyConfig.BodyMeasurements.Add(TEXT("Masculine/Feminine"), MasculineFeminine);
-	OutBodyConfig.BodyMeasurements.Add(TEXT("Muscularity"), FMath::FRandRange(-1.5f, 1.5f));
-	OutBodyConfig.BodyMeasurements.Add(TEXT("Fat"), FMath::FRandRange(-0.5f, 1.0f));
-	OutBodyConfig.BodyMeasurements.Add(TEXT("Height"), FMath::FRandRange(150.0f, 185.0f));
 
-	OutBodyConfig.QualityLevel = QualityLevelConfig;
+	// Texture synthesis is off or produced nothing - assemble with what the character has
+	UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: High-resolution textures unavailable, assembling without them"), Job.JobId);
+	Metrics.IncrementCounter(TEXT("TextureFetch.Skipped"));
+	Job.TextureTask = EBatchGenTaskState::Done;
+}
 
-	int32 EthnicityRoll = FMath::RandRange(1, 100);
-	FString EthnicityCode;
+void UEditorBatchGenerationSubsystem::UpdateTextureFetch(FBatchGenerationJob& Job, UMetaHumanCharacterEditorSubsystem* EditorSubsystem)
+{
+	UMetaHumanCharacter* Character = Job.Character.Get();
+	const double Now = FPlatformTime::Seconds();
 
-	if (EthnicityRoll <= 90)
+	// A failed request waiting for its retry
+	if (Job.TextureTask == EBatchGenTaskState::Failed && Job.TextureRetryTime > 0.0)
 	{
-		OutAppearanceConfig.SkinSettings.Skin.U = FMath::FRandRange(0.25f, 0.4f);
-		OutAppearanceConfig.SkinSettings.Skin.V = FMath::FRandRange(0.0f, 0.3f);
+		if (Now < Job.TextureRetryTime)
+			return;
 
-		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.PrimaryColorU = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.PrimaryColorV = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.SecondaryColorU = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.SecondaryColorV = 0.0f;
+		Job.TextureRetryTime = 0.0;
+		if (UMetaHumanParametricGenerator::DownloadTextureSourceData(Character, BatchTextureResolution) || EditorSubsystem->IsRequestingHighResolutionTextures(Character))
+		{
+			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Texture fetch retry %d started"), Job.JobId, Job.TextureRetryCount);
+			Job.TextureTask = EBatchGenTaskState::Running;
+			Job.TextureDeadline = Now + TextureTimeoutConfig;
+		}
+		else
+		{
+			Metrics.RecordStage(BatchGenStage::TextureFetch, Now - Job.TextureStartTime, false);
+		}
+		return;
+	}
 
-		OutAppearanceConfig.EyesSettings.EyeRight.Iris.PrimaryColorU = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeRight.Iris.PrimaryColorV = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeRight.Iris.SecondaryColorU = 0.0f;
-		OutAppearanceConfig.EyesSettings.EyeRight.Iris.SecondaryColorV = 0.0f;
+	if (Job.TextureTask != EBatchGenTaskState::Running)
+		return;
 
-		OutAppearanceConfig.WardrobeConfig.HairParameters->Melanin = 1.0f;
-		EthnicityCode = TEXT("AS"); // Asian
+	FString FailureMessage;
+	if (EditorSubsystem->IsRequestingHighResolutionTextures(Character))
+	{
+		if (Now < Job.TextureDeadline)
+			return;
+		FailureMessage = FString::Printf(TEXT("timed out after %.0f seconds"), TextureTimeoutConfig);
 	}
-	else if (EthnicityRoll <= 95)
+	else if (Character->HasHighResolutionTextures())
 	{
-		OutAppearanceConfig.SkinSettings.Skin.U = FMath::FRandRange(0.0f, 0.2f);
-		OutAppearanceConfig.SkinSettings.Skin.V = FMath::FRandRange(0.4f, 1.0f);
-		EthnicityCode = TEXT("AF"); // African
+		Job.TextureTask = EBatchGenTaskState::Done;
+		Metrics.RecordStage(BatchGenStage::TextureFetch, Now - Job.TextureStartTime, true);
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓ Job %d: Textures downloaded in %.1f seconds"),
+			Job.JobId, Now - Job.TextureStartTime);
+
+		if (bUseTextureCacheConfig && !Job.bTexturesFromCache)
+		{
+			int32 EvictedCount = 0;
+			FMetaHumanTextureCache::Store(Character, UMetaHumanParametricGenerator::GetTextureResolutionSize(BatchTextureResolution),
+				static_cast<int64>(TextureCacheMaxMBConfig) * 1024 * 1024, EvictedCount);
+			Metrics.IncrementCounter(TEXT("TextureCache.Evictions"), EvictedCount);
+		}
+		return;
 	}
 	else
 	{
-		OutAppearanceConfig.SkinSettings.Skin.U = FMath::FRandRange(0.6f, 1.0f);
-		OutAppearanceConfig.SkinSettings.Skin.V = FMath::FRandRange(0.0f, 1.0f);
-		EthnicityCode = TEXT("EU"); // European
+		FailureMessage = TEXT("request finished without high-resolution textures");
 	}
 
-	// OutAppearanceConfig.WardrobeConfig.HairParameters->Redness = FMath::FRandRange(0.0f, 1.0f);
-	OutAppearanceConfig.WardrobeConfig.HairParameters->Roughness = FMath::FRandRange(0.0f, 1.0f);
-	OutAppearanceConfig.WardrobeConfig.HairParameters->Whiteness = FMath::FRandRange(0.0f, 1.0f);
-	OutAppearanceConfig.WardrobeConfig.HairParameters->Lightness = FMath::FRandRange(0.0f, 1.0f);
+	// The fetch has its own retries, so a flaky download never costs the rig
+	Job.TextureTask = EBatchGenTaskState::Failed;
+	if (Job.TextureRetryCount < MaxRetriesConfig)
+	{
+		const float Delay = GetRetryDelay(Job.TextureRetryCount);
+		Job.TextureRetryCount++;
+		Job.TextureRetryTime = Now + Delay;
+		Metrics.IncrementCounter(TEXT("TextureFetch.Retries"));
+		UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: Texture fetch %s, retry %d/%d in %.1f seconds"),
+			Job.JobId, *FailureMessage, Job.TextureRetryCount, MaxRetriesConfig, Delay);
+		return;
+	}
 
-	// Randomize wardrobe colors
-	OutAppearanceConfig.WardrobeConfig.ColorConfig.PrimaryColorShirt = FLinearColor(
-		FMath::FRandRange(0.0f, 1.0f),  // R
-		FMath::FRandRange(0.0f, 1.0f),  // G
-		FMath::FRandRange(0.0f, 1.0f),  // B
-		1.0f  // A
-	);
-	OutAppearanceConfig.WardrobeConfig.ColorConfig.PrimaryColorShort = FLinearColor(
-		FMath::FRandRange(0.0f, 1.0f),  // R
-		FMath::FRandRange(0.0f, 1.0f),  // G
-		FMath::FRandRange(0.0f, 1.0f),  // B
-		1.0f  // A
-	);
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Job %d: Texture fetch %s"), Job.JobId, *FailureMessage);
+	Metrics.RecordStage(BatchGenStage::TextureFetch, Now - Job.TextureStartTime, false);
+}
 
-	OutAppearanceConfig.SkinSettings.Skin.Roughness = FMath::FRandRange(0.0f, 1.0f);
-	OutAppearanceConfig.SkinSettings.Skin.bShowTopUnderwear = true;
-	OutAppearanceConfig.SkinSettings.Skin.BodyTextureIndex = FMath::RandRange(0, 8);
-	// see I:\UE_5.6\Engine\Plugins\MetaHuman\MetaHumanCharacter\Content\Optional\TextureSynthesis\TS-1.3-D_UE_res-1024_nchr-153\texture_attributes.json
-	//a['attributes']['Face Stubble']['values']          
-	// [0, 3, 1, 1, 2, 0, 3, 0, 3, 1, 0, 1, 0, 2, 0, 3, 0, 0, 0, 1, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 
-    //  0, 1, 0, 1, 1, 0, 0, 2, 0, 0, 2, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 1, 2, 0, 0, 1, 0, 3, 0, 2, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 0, 2, 0, 0, 3, 0, 0, 0, 2, 0, 3, 2, 0, 0, 0, 1, 0, 3, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 1, 0, 2, 2, 2, 0, 3, 0, 0, 1, 0, 2, 1, 0, 1, 1, 0, 2, 0, 1, 0, 3]
-	// 0-1 for female, 0-3 for male
-	const TArray<int32> FaceTextureStubbleMapp = {0, 3, 1, 1, 2, 0, 3, 0, 3, 1, 0, 1, 0, 2, 0, 3, 0, 0, 0, 1, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 2, 0, 0, 2, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 1, 2, 0, 0, 1, 0, 3, 0, 2, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 0, 2, 0, 0, 3, 0, 0, 0, 2, 0, 3, 2, 0, 0, 0, 1, 0, 3, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 1, 0, 2, 2, 2, 0, 3, 0, 0, 1, 0, 2, 1, 0, 1, 1, 0, 2, 0, 1, 0, 3};
-	TArray<int32> FemaleFaceTextureIndexSet;
-	TArray<int32> MaleFaceTextureIndexSet;
-	for (int32 Index = 0; Index < FaceTextureStubbleMapp.Num(); ++Index)
+void UEditorBatchGenerationSubsystem::HandleAssemblingState(FBatchGenerationJob& Job)
+{
+	if (!Job.Character.IsValid())
 	{
-		int32 StubbleValue = FaceTextureStubbleMapp[Index];
-		// if (StubbleValue >= 0 && StubbleValue <= 1)
-		if (StubbleValue >= 0 && StubbleValue <= 0)
+		EndStage(Job, BatchGenStage::Assemble, false);
+		FailJob(Job, EMetaHumanGenerationFailure::Assemble, TEXT("Character reference lost during assembly"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Job %d: Starting Character Assembly ==="), Job.JobId);
+
+	// Variants after the first re-dress the rigged character and assemble it under their own name
+	FMetaHumanAssemblyOptions AssemblyOptions;
+	AssemblyOptions.bFetchTextures = false; // Already fetched as its own stage
+	AssemblyOptions.bAsyncSave = bAsyncSaveConfig;
+	if (JobQueue.IsValid())
+	{
+		// Other workers assemble into the same output path - keep the shared packages apart, under a name
+		// that survives restarts so they are written once per worker rather than once per process
+		const FString InstanceName = WorkerInstanceConfig.IsEmpty() ? FString(FPlatformProcess::ComputerName()) : WorkerInstanceConfig;
+		AssemblyOptions.CommonFolderSuffix = TEXT("_") + FPaths::MakeValidFileName(InstanceName, TEXT('_'));
+	}
+	const FString AssemblyName = UMetaHumanBatchPlanner::GetVariantName(Job.CharacterName, Job.VariantIndex);
+	if (Job.VariantIndex > 0)
+	{
+		const FMetaHumanPrepareContext& Base = Job.PrepareContext;
+		FMetaHumanAppearanceConfig VariantAppearance = Base.AppearanceConfig;
+		UMetaHumanBatchPlanner::ExpandWardrobeVariant(
+			Job.ManifestEntry, Job.VariantIndex, Base.BodyConfig, Base.AppearanceConfig.WardrobeConfig, VariantAppearance.WardrobeConfig);
+
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Variant %d/%d '%s'"),
+			Job.JobId, Job.VariantIndex + 1, VariantsPerRigConfig, *AssemblyName);
+
+		if (!UMetaHumanParametricGenerator::ApplyWardrobe(Job.Character.Get(), VariantAppearance.WardrobeConfig, bBuildPreviewConfig))
 		{
-			FemaleFaceTextureIndexSet.Add(Index);
+			// A bad wardrobe item only costs this variant - the rig is still good for the others
+			UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: Skipping variant '%s', wardrobe could not be applied"),
+				Job.JobId, *AssemblyName);
+			Metrics.IncrementCounter(TEXT("Variants.Skipped"));
+			FinishAssemblyVariant(Job);
+			return;
 		}
-		if (StubbleValue >= 0 && StubbleValue <= 3)
+
+		UMetaHumanConfigSerializer::SaveGenerationSession(AssemblyName, OutputPathConfig, Base.BodyConfig, VariantAppearance, TEXT("Assembling"), BatchTextureResolution);
+		AssemblyOptions.NameOverride = AssemblyName;
+	}
+
+	// Call Step 2: Assemble - once per quality level of the batch, all from the same rig and textures
+	TArray<FMetaHumanAssemblyStats> LevelStats;
+	bool bSuccess = UMetaHumanParametricGenerator::AssembleCharacter(
+		Job.Character.Get(),
+		OutputPathConfig,
+		BatchQualityLevels,
+		AssemblyOptions,
+		LevelStats
+	);
+
+	for (int32 LevelIndex = 0; LevelIndex < LevelStats.Num(); ++LevelIndex)
+	{
+		// On failure only the last level reached failed
+		const FMetaHumanAssemblyStats& AssemblyStats = LevelStats[LevelIndex];
+		const bool bLevelSuccess = bSuccess || LevelIndex < LevelStats.Num() - 1;
+		if (AssemblyStats.PipelineSeconds > 0.0f)
 		{
-			MaleFaceTextureIndexSet.Add(Index);
+			// Reached the build - the pipeline was looked up
+			Metrics.RecordStage(BatchGenStage::AssemblePipeline, AssemblyStats.PipelineSeconds, bLevelSuccess);
+			Metrics.IncrementCounter(AssemblyStats.bPipelineCacheHit ? TEXT("PipelineCache.Hits") : TEXT("PipelineCache.Misses"));
 		}
+		Metrics.RecordStage(BatchGenStage::AssembleBuild, AssemblyStats.BuildSeconds, bLevelSuccess);
+		Metrics.RecordStage(BatchGenStage::AssembleSave, AssemblyStats.SaveSeconds, bLevelSuccess);
+		Metrics.IncrementCounter(TEXT("Assemble.SavedPackages"), AssemblyStats.SavedPackages);
+		Metrics.IncrementCounter(TEXT("Assemble.SavedBytes"), AssemblyStats.SavedBytes);
+		Metrics.IncrementCounter(TEXT("Assemble.SkippedPackages"), AssemblyStats.SkippedPackages);
+		Metrics.IncrementCounter(TEXT("Assemble.SkippedBytes"), AssemblyStats.SkippedBytes);
 	}
-	int32 RandomIndex;
-	if (bIsFemale)
+	if (bSuccess)
 	{
-		RandomIndex = FemaleFaceTextureIndexSet[FMath::RandRange(0, FemaleFaceTextureIndexSet.Num() - 1)];
+		Metrics.IncrementCounter(TEXT("Assemble.QualityLevels"), LevelStats.Num());
+	}
+	EndStage(Job, BatchGenStage::Assemble, bSuccess);
+
+	if (bSuccess)
+	{
+		GeneratedCount++;
+		Metrics.RecordCharacter(true);
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: ✓✓✓ Character generation complete! ✓✓✓"));
+		for (int32 LevelIndex = 0; LevelIndex < LevelStats.Num(); ++LevelIndex)
+		{
+			const FMetaHumanAssemblyStats& AssemblyStats = LevelStats[LevelIndex];
+			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Character '%s' saved to %s (%d package(s), %.1f MB in %.1f s)"),
+				*AssemblyName,
+				*UMetaHumanParametricGenerator::GetQualityOutputPath(OutputPathConfig, BatchQualityLevels[LevelIndex], BatchQualityLevels),
+				AssemblyStats.SavedPackages, AssemblyStats.SavedBytes / (1024.0 * 1024.0), AssemblyStats.SaveSeconds);
+		}
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Total characters generated: %d"), GeneratedCount);
+		if (AssemblyOptions.bAsyncSave)
+		{
+			Job.PendingSaveSessions.AddUnique(AssemblyName);
+		}
+		FinishAssemblyVariant(Job);
 	}
 	else
 	{
-		RandomIndex = MaleFaceTextureIndexSet[FMath::RandRange(0, MaleFaceTextureIndexSet.Num() - 1)];
+		// A retry re-applies and re-assembles the same variant
+		const bool bSaveFailed = LevelStats.Num() > 0 && LevelStats.Last().bSaveFailed;
+		FailJob(Job, EMetaHumanGenerationFailure::Assemble,
+			bSaveFailed ? TEXT("Failed to save assembled packages") : TEXT("Failed to assemble character"));
 	}
-	OutAppearanceConfig.SkinSettings.Skin.FaceTextureIndex = RandomIndex;
-	// OutAppearanceConfig.SkinSettings.Skin.FaceTextureIndex = FMath::RandRange(0, 152);
+}
 
-	if (EthnicityCode == TEXT("AS")) // Asian
+void UEditorBatchGenerationSubsystem::FinishAssemblyVariant(FBatchGenerationJob& Job)
+{
+	// Stay in Assembling - the next variant is assembled on the next tick, with a fresh lease
+	Job.VariantIndex++;
+	if (Job.VariantIndex < VariantsPerRigConfig)
 	{
-		OutAppearanceConfig.SkinSettings.Freckles.Density = FMath::FRandRange(0.0f, 0.5f);
-		OutAppearanceConfig.SkinSettings.Freckles.Strength = FMath::FRandRange(0.0f, 0.5f);
+		return;
 	}
-	else
+
+	// The entry is only done once its files are on disk
+	if (Job.PendingSaveSessions.Num() > 0)
 	{
-		OutAppearanceConfig.SkinSettings.Freckles.Density = FMath::FRandRange(0.0f, 1.0f);
-		OutAppearanceConfig.SkinSettings.Freckles.Strength = FMath::FRandRange(0.0f, 1.0f);
+		TransitionToState(Job, EBatchGenState::Saving);
+		return;
 	}
-	OutAppearanceConfig.SkinSettings.Freckles.Saturation = FMath::FRandRange(0.0f, 1.0f);
-	OutAppearanceConfig.SkinSettings.Freckles.ToneShift = FMath::FRandRange(0.0f, 1.0f);
+	CompleteJob(Job);
+}
 
-	int32 FrecklesRoll = FMath::RandRange(1, 100);
-	if (FrecklesRoll <= 70)
+void UEditorBatchGenerationSubsystem::HandleSavingState(FBatchGenerationJob& Job)
+{
+	// Polled every tick - the engine's writer is the only reliable word on whether the files are complete
+	if (UMetaHumanParametricGenerator::HasPendingAssemblySaves() && FPlatformTime::Seconds() < Job.StageDeadline)
 	{
-		OutAppearanceConfig.SkinSettings.Freckles.Mask = EMetaHumanCharacterFrecklesMask::None;
+		return;
 	}
-	else
+	FinishSaving(Job);
+}
+
+void UEditorBatchGenerationSubsystem::FinishSaving(FBatchGenerationJob& Job)
+{
+	if (UMetaHumanParametricGenerator::HasPendingAssemblySaves())
 	{
-		OutAppearanceConfig.SkinSettings.Freckles.Mask = static_cast<EMetaHumanCharacterFrecklesMask>(FMath::RandRange(1, 3));
-	}
-
-	OutAppearanceConfig.HeadModelSettings.Eyelashes.bEnableGrooms = false;
-
-	// {
-	// 	// random hair from UE Metahuman Plugin Content
-	// 	FString BaseHairPath = TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair");
-	// 	FString RandomHairItem = UMetaHumanParametricGenerator::GetRandomWardrobeItemFromPath(TEXT("Hair"), BaseHairPath);
-	// 	OutAppearanceConfig.WardrobeConfig.HairPath = RandomHairItem;
-	// 	UE_LOG(LogTemp, Log, TEXT("Generated random hair item: %s"), *RandomHairItem);
-	// }
-	{
-		// Random hair from predefined list instead of MetaHuman plugin
-		// TArray<FString> AllHairPaths = {
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBuns.WI_Hair_S_UpdoBuns"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBraids.WI_Hair_S_UpdoBraids"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Updo.WI_Hair_S_Updo"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SweptUp.WI_Hair_S_SweptUp"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SlickBack.WI_Hair_S_SlickBack"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SideSweptFringe.WI_Hair_S_SideSweptFringe"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_RecedeMessy.WI_Hair_S_RecedeMessy"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_PulledBack.WI_Hair_S_PulledBack"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Pixie.WI_Hair_S_Pixie"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Messy.WI_Hair_S_Messy"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_LowPonytail.WI_Hair_S_LowPonytail"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_HairLoss.WI_Hair_S_HairLoss"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CurlyFade.WI_Hair_S_CurlyFade"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Cornrows.WI_Hair_S_Cornrows"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CoilBuzzCut.WI_Hair_S_CoilBuzzCut"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Coil.WI_Hair_S_Coil"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Clean.WI_Hair_S_Clean"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Casual.WI_Hair_S_Casual"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BuzzCut.WI_Hair_S_BuzzCut"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BrushCut.WI_Hair_S_BrushCut"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BobLayered.WI_Hair_S_BobLayered"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BaldingStubble.WI_Hair_S_BaldingStubble"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_AfroFade.WI_Hair_S_AfroFade"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_360Waves.WI_Hair_S_360Waves"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_TwistedBraids.WI_Hair_M_TwistedBraids"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_SideSweptFringe.WI_Hair_M_SideSweptFringe"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Mohawk.WI_Hair_M_Mohawk"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Layered.WI_Hair_M_Layered"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_FauxMohawk.WI_Hair_M_FauxMohawk"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobStraight.WI_Hair_M_BobStraight"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobSlick.WI_Hair_M_BobSlick"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobMessy.WI_Hair_M_BobMessy"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobCurly.WI_Hair_M_BobCurly"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobBangs.WI_Hair_M_BobBangs"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_StraightBangs.WI_Hair_L_StraightBangs"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_Straight.WI_Hair_L_Straight"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_MessyClumps.WI_Hair_L_MessyClumps"),
-		// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_AfroCurly.WI_Hair_L_AfroCurly")
-		// };
-
-		TArray<FString> MaleHairPaths = {
-			// 短发
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SlickBack.WI_Hair_S_SlickBack"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SweptUp.WI_Hair_S_SweptUp"),
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_PulledBack.WI_Hair_S_PulledBack"), //狂怒 男主发型
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Messy.WI_Hair_S_Messy"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_HairLoss.WI_Hair_S_HairLoss"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CurlyFade.WI_Hair_S_CurlyFade"),  // 短卷
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CoilBuzzCut.WI_Hair_S_CoilBuzzCut"), //
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BuzzCut.WI_Hair_S_BuzzCut"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BrushCut.WI_Hair_S_BrushCut"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Clean.WI_Hair_S_Clean"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_360Waves.WI_Hair_S_360Waves"),  // 短寸
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Casual.WI_Hair_S_Casual"),  // 商务短发
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Coil.WI_Hair_S_Coil"),
-
-			// 中短发 
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Pixie.WI_Hair_S_Pixie"),  // 类似碎盖 带刘海
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SideSweptFringe.WI_Hair_S_SideSweptFringe"),  // 普通三七分
-
-
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_RecedeMessy.WI_Hair_S_RecedeMessy"),  // 秃
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BaldingStubble.WI_Hair_S_BaldingStubble"), // 更秃
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_AfroFade.WI_Hair_S_AfroFade"),  // 短蓬松卷,
-			
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Mohawk.WI_Hair_M_Mohawk"), // cyber phonk 发型 
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_FauxMohawk.WI_Hair_M_FauxMohawk"), // cyber phonk 发型
-			
-		};
-		TArray<FString> FemaleHairPaths = {
-			// 中长发
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_LowPonytail.WI_Hair_S_LowPonytail"), // 类似学生头
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_StraightBangs.WI_Hair_L_StraightBangs"),
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_Straight.WI_Hair_L_Straight"),  // 容易看起来像西方人
-			TEXT("/Game/MHPKG/hair_l_highponytail/WI_Hair_L_HighPonytail.WI_Hair_L_HighPonytail"),
-
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBuns.WI_Hair_S_UpdoBuns"), // 樱桃 短扎
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBraids.WI_Hair_S_UpdoBraids"),  // 樱桃 短扎
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Updo.WI_Hair_S_Updo"), // 樱桃 短扎
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Layered.WI_Hair_M_Layered")  // 西方男生微卷到肩
-
-			// bob 短发系列
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobStraight.WI_Hair_M_BobStraight"), // 直发蘑菇头
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobSlick.WI_Hair_M_BobSlick"),
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobMessy.WI_Hair_M_BobMessy"),  // 
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobCurly.WI_Hair_M_BobCurly"),  // 到肩 微卷
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobBangs.WI_Hair_M_BobBangs"),  // 到颈 哆啦/盖茨比Daisy头
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BobLayered.WI_Hair_S_BobLayered")  // 到颈 微卷
-
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_TwistedBraids.WI_Hair_M_TwistedBraids"), // 脏辫
-	
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_MessyClumps.WI_Hair_L_MessyClumps"),  // 指环王精灵女王发型
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_AfroCurly.WI_Hair_L_AfroCurly") //爆炸头
-		};
-		TArray<FString> UnisexHairPaths = {
-			
-			
-			
-			// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Cornrows.WI_Hair_S_Cornrows"), // 脏辫背头
-			TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_SideSweptFringe.WI_Hair_M_SideSweptFringe"),  // 颈部长度 三七分 颈后微卷
-			
-			
-		};
-		TArray<FString> FinalHairPaths;
-		if (bIsFemale)
-		{
-			FinalHairPaths = FemaleHairPaths;
-			FinalHairPaths.Append(UnisexHairPaths);
+		UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: Waiting for the remaining package writes"), Job.JobId);
+		Metrics.IncrementCounter(TEXT("Assemble.SaveFlushBlocked"));
+		UMetaHumanParametricGenerator::WaitForAssemblySaves();
+	}
+	EndStage(Job, BatchGenStage::AssembleSaveFlush, true);
+
+	for (const FString& SessionName : Job.PendingSaveSessions)
+	{
+		if (!UMetaHumanConfigSerializer::UpdateSessionStatus(SessionName, TEXT("Completed")))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: Failed to mark session '%s' completed"), Job.JobId, *SessionName);
 		}
-		else
+	}
+	Job.PendingSaveSessions.Reset();
+
+	CompleteJob(Job);
+}
+
+void UEditorBatchGenerationSubsystem::CompleteJob(FBatchGenerationJob& Job)
+{
+	Metrics.RecordStage(BatchGenStage::Total, FPlatformTime::Seconds() - Job.JobStartTime, true);
+	if (JobQueue.IsValid())
+	{
+		JobQueue->MarkDone(Job.ManifestEntry.Index, true);
+	}
+	TransitionToState(Job, EBatchGenState::Complete);
+}
+
+int32 UEditorBatchGenerationSubsystem::GetNumJobsInSlots() const
+{
+	int32 NumJobs = 0;
+	int32 NumSavingJobs = 0;
+	for (const FBatchGenerationJob& Job : Jobs)
+	{
+		if (Job.State != EBatchGenState::Saving)
 		{
-			FinalHairPaths = MaleHairPaths;
-			FinalHairPaths.Append(UnisexHairPaths);
-		}
-
-		int32 Index = FMath::RandRange(0, FinalHairPaths.Num() - 1);
-		OutAppearanceConfig.WardrobeConfig.HairPath = FinalHairPaths[Index];
-		UE_LOG(LogTemp, Log, TEXT("Generated random hair item: %s"), *FinalHairPaths[Index]);
-	}
-
-
-
-	// {
-	// 	// random clothing from UE Metahuman Plugin Content
-	// 	FString BaseClothingPath = TEXT("/MetaHumanCharacter/Optional/Clothing");
-	// 	// Get random clothing item
-	// 	FString RandomClothingItem = UMetaHumanParametricGenerator::GetRandomWardrobeItemFromPath(TEXT("Outfits"), BaseClothingPath);
-	// 	OutAppearanceConfig.WardrobeConfig.ClothingPaths.Empty();
-	// 	OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomClothingItem);
-	// 	UE_LOG(LogTemp, Log, TEXT("Generated random clothing item: %s"), *RandomClothingItem);
-	// }
-	{
-		int32 Roll;
-		OutAppearanceConfig.WardrobeConfig.ClothingPaths.Empty();
-		
-
-		const TArray<FString> UpperAndLowerCloth = {
-			TEXT("/MetaHumanCharacter/Optional/Clothing/WI_DefaultGarment.WI_DefaultGarment")
-		};
-		const TArray<FString> UpperCloth = {
-			// New Ones
-			"/Game/GoodWI/Upper/WI_Puffer_Jacket.WI_Puffer_Jacket", //
-			// "/Game/GoodWI/Upper/WI_Shirts.WI_Shirts",  //下摆太长，容易穿模
-			"/Game/GoodWI/Upper/WI_Sweater.WI_Sweater",
-			"/Game/GoodWI/Upper/WI_Tank_Top.WI_Tank_Top",
-			"/Game/GoodWI/Upper/WI_Track_Suit.WI_Track_Suit",
-
-
-			"/Game/GoodWI/Upper/WI_Red_Shirt.WI_Red_Shirt",
-			"/Game/GoodWI/Upper/WI_SweaterNew.WI_SweaterNew",
-		};
-		const TArray<FString> LowerCloth = {
-			// New Ones
-			"/Game/GoodWI/Lower/WI_Bonkers.WI_Bonkers",
-			"/Game/GoodWI/Lower/WI_Cargo.WI_Cargo",
-			"/Game/GoodWI/Lower/WI_Jeans.WI_Jeans",
-			"/Game/GoodWI/Lower/WI_Pant.WI_Pant",  // Warning: this may cause collision with UpperCloth
-			"/Game/GoodWI/Lower/WI_Track_Pant.WI_Track_Pant",
-
-			"/Game/GoodWI/Lower/WI_Baggy_Pants.WI_Baggy_Pants",
-			"/Game/GoodWI/Lower/WI_Cyber_Punk_Pants.WI_Cyber_Punk_Pants",
-			"/Game/GoodWI/Lower/WI_Jeans2.WI_Jeans2",
-			"/Game/GoodWI/Lower/WI_Jeans_1.WI_Jeans_1",
-			"/Game/GoodWI/Lower/WI_Jeans_3.WI_Jeans_3",
-			"/Game/GoodWI/Lower/WI_Colorful_Sweats.WI_Colorful_Sweats",
-		};
-
-		const TArray<FString> Shoes = {
-			"/Game/GoodWI/Shoes/WI_Short_Boots.WI_Short_Boots"
-		};
-
-		const TArray<FString> FullSuit = { };
-
-		const TArray<FString> OtherItems = {
-			"/Game/GoodWI/OtherItems/WI_Bag.WI_Bag"
-		};
-		
-		Roll = FMath::RandRange(1, 100);
-		if (Roll <= 20) // use UpperAndLowerCloth
-		{
-		 	OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomChoice(UpperAndLowerCloth));
+			NumJobs++;
 		}
 		else
 		{
-			OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomChoice(UpperCloth));
-			OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomChoice(LowerCloth));
+			NumSavingJobs++;
 		}
+	}
+	return NumJobs + FMath::Max(0, NumSavingJobs - MaxConcurrentJobsConfig);
+}
 
-		
-		// Shoes
-		Roll = FMath::RandRange(1, 100);
-		if (Roll <= 15) // Do not wear shoes
-		{
-			// pass
-		}
-		else
+void UEditorBatchGenerationSubsystem::ReleaseJobCharacter(FBatchGenerationJob& Job)
+{
+	// A job that failed during preparation only has the character in its prepare context
+	UMetaHumanCharacter* Character = Job.Character.IsValid() ? Job.Character.Get() : Job.PrepareContext.Character.Get();
+	Job.Character.Reset();
+	Job.PrepareContext.Character = nullptr;
+	if (!Character)
+	{
+		return;
+	}
+
+	TArray<FString> AssemblyFolders;
+	for (const EMetaHumanQualityLevel QualityLevel : BatchQualityLevels)
+	{
+		const FString LevelOutputPath = UMetaHumanParametricGenerator::GetQualityOutputPath(OutputPathConfig, QualityLevel, BatchQualityLevels);
+		for (int32 VariantIndex = 0; VariantIndex < VariantsPerRigConfig; ++VariantIndex)
 		{
-			OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomChoice(Shoes));
+			AssemblyFolders.Add(LevelOutputPath / UMetaHumanBatchPlanner::GetVariantName(Job.CharacterName, VariantIndex));
 		}
-		
+	}
+
+	// Everything a finished job keeps is on disk by now - what is still dirty belongs to a failed or abandoned attempt
+	const int32 NumReleased = UMetaHumanParametricGenerator::ReleaseCharacter(Character, AssemblyFolders, /*bDiscardUnsaved*/ true);
+	Metrics.IncrementCounter(TEXT("Teardown.PackagesReleased"), NumReleased);
+	JobsSinceCollection++;
+
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Released '%s' (%d package(s))"),
+		Job.JobId, *Job.CharacterName, NumReleased);
+}
+
+void UEditorBatchGenerationSubsystem::CollectGarbageIfDue(bool bForce)
+{
+	if (JobsSinceCollection == 0 || GCIntervalJobsConfig <= 0 || (!bForce && JobsSinceCollection < GCIntervalJobsConfig))
+	{
+		return;
+	}
+
+	// Loop delays keep released jobs in the table - their prepare contexts are cleared, so they do not hold anything
+	const double StartTime = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	Metrics.RecordStage(BatchGenStage::TeardownGC, FPlatformTime::Seconds() - StartTime, true);
+
+	// Process-wide: jobs still in flight grow it too, so this is not what the released jobs kept
+	const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	const int64 Delta = static_cast<int64>(UsedPhysical) - static_cast<int64>(LastCollectionUsedPhysical);
+	Metrics.RecordCollectionMemoryDelta(Delta, JobsSinceCollection);
+	Metrics.RecordMemory(UsedPhysical);
 
-		// OtherItems
-		Roll = FMath::RandRange(1, 100);
-		if (Roll <= 10) // wear other items
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Garbage collected after %d job(s) in %.2f s: %.1f MB used, %+.1f MB since the last collection (%+.1f MB per job)"),
+		JobsSinceCollection, FPlatformTime::Seconds() - StartTime, UsedPhysical / (1024.0 * 1024.0), Delta / (1024.0 * 1024.0),
+		Delta / (1024.0 * 1024.0) / JobsSinceCollection);
+
+	LastCollectionUsedPhysical = UsedPhysical;
+	JobsSinceCollection = 0;
+}
+
+void UEditorBatchGenerationSubsystem::HandleCompleteState(FBatchGenerationJob& Job, bool bStateEntered, float DeltaTime)
+{
+	if (bStateEntered)
+	{
+		// Log completion (only once per character generation)
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: === Job %d: Generation Complete ==="), Job.JobId);
+		ReleaseJobCharacter(Job);
+
+		if (!bLoopGenerationEnabled)
 		{
-			OutAppearanceConfig.WardrobeConfig.ClothingPaths.Add(RandomChoice(OtherItems));
+			TransitionToState(Job, EBatchGenState::Idle);
+			return;
 		}
 
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Loop mode enabled - slot is reused in %.1f seconds"), LoopDelayConfig);
+		Job.LoopDelayTimer = LoopDelayConfig;
+		return;
+	}
+
+	// Handle loop delay timer - the job keeps its slot until the delay has elapsed
+	Job.LoopDelayTimer -= DeltaTime;
+	if (Job.LoopDelayTimer <= 0.0f)
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d loop delay finished, releasing slot"), Job.JobId);
+		TransitionToState(Job, EBatchGenState::Idle);
+	}
+}
+
+void UEditorBatchGenerationSubsystem::HandleErrorState(FBatchGenerationJob& Job)
+{
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: === Job %d: Error State ==="), Job.JobId);
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Character: %s"), *Job.CharacterName);
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Failure: %s"), *UEnum::GetValueAsString(Job.FailureReason));
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Error: %s"), *Job.LastErrorMessage);
+
+	if (IsRetryableFailure(Job.FailureReason) && Job.RetryCount < MaxRetriesConfig)
+	{
+		Job.BackoffRemaining = GetRetryDelay(Job.RetryCount);
+		Job.RetryCount++;
+		Metrics.IncrementCounter(TEXT("Retries"));
+
+		UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: Job %d: Retry %d/%d in %.1f seconds"),
+			Job.JobId, Job.RetryCount, MaxRetriesConfig, Job.BackoffRemaining);
+		TransitionToState(Job, EBatchGenState::Backoff);
+		return;
+	}
+
+	// Out of retries - record it and release the slot so the other jobs keep going
+	FailedCount++;
+	Metrics.RecordCharacter(false);
+	Metrics.RecordStage(BatchGenStage::Total, FPlatformTime::Seconds() - Job.JobStartTime, false);
+	AddDeadLetter(Job);
+	if (JobQueue.IsValid())
+	{
+		JobQueue->MarkDone(Job.ManifestEntry.Index, false);
+	}
+	ReleaseJobCharacter(Job);
+	TransitionToState(Job, EBatchGenState::Idle);
+}
+
+void UEditorBatchGenerationSubsystem::HandleBackoffState(FBatchGenerationJob& Job, float DeltaTime)
+{
+	Job.BackoffRemaining -= DeltaTime;
+	if (Job.BackoffRemaining > 0.0f)
+		return;
+
+	UMetaHumanCharacter* Character = Job.Character.Get();
+	const EMetaHumanGenerationFailure Reason = Job.FailureReason;
+	Job.FailureReason = EMetaHumanGenerationFailure::None;
+
+	// Retry only the step that failed when the character survived the failure
+	// The texture fetch keeps running (or stays done) while the rig is retried, and the other way round
+	if (Character && Reason == EMetaHumanGenerationFailure::Rig && UMetaHumanParametricGenerator::StartAutoRig(Character))
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Retrying AutoRig"), Job.JobId);
+		Job.RigTask = EBatchGenTaskState::Running;
+		TransitionToState(Job, EBatchGenState::WaitingForRig);
+		return;
+	}
+
+	if (Character && Reason == EMetaHumanGenerationFailure::Texture)
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Retrying texture fetch"), Job.JobId);
+		Job.TextureTask = EBatchGenTaskState::NotStarted;
+		Job.TextureRetryCount = 0;
+		Job.TextureRetryTime = 0.0;
+		StartTextureFetch(Job, Character, true);
+		TransitionToState(Job, EBatchGenState::WaitingForRig);
+		return;
+	}
+
+	if (Character && Reason == EMetaHumanGenerationFailure::Assemble)
+	{
+		UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Retrying assembly"), Job.JobId);
+		TransitionToState(Job, EBatchGenState::Assembling);
+		return;
+	}
+
+	// Otherwise start the character over
+	UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Retrying from scratch"), Job.JobId);
+	ReleaseJobCharacter(Job);
+	TransitionToState(Job, EBatchGenState::Preparing);
+}
+
+// ============================================================================
+// Failure Handling
+// ============================================================================
+
+void UEditorBatchGenerationSubsystem::SetRetryPolicy(int32 MaxRetries, float BaseDelay, float MaxDelay)
+{
+	MaxRetriesConfig = FMath::Max(0, MaxRetries);
+	RetryBaseDelayConfig = FMath::Max(0.0f, BaseDelay);
+	RetryMaxDelayConfig = FMath::Max(RetryBaseDelayConfig, MaxDelay);
+}
+
+void UEditorBatchGenerationSubsystem::SetStageTimeouts(float RigTimeout, float TextureTimeout)
+{
+	RigTimeoutConfig = FMath::Max(1.0f, RigTimeout);
+	TextureTimeoutConfig = FMath::Max(1.0f, TextureTimeout);
+}
+
+void UEditorBatchGenerationSubsystem::FailJob(FBatchGenerationJob& Job, EMetaHumanGenerationFailure Reason, const FString& Message)
+{
+	Job.FailureReason = Reason;
+	Job.LastErrorMessage = Message;
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: ✗ Job %d: %s"), Job.JobId, *Message);
+
+	Metrics.IncrementCounter(*FString::Printf(TEXT("Failure.%s"),
+		*StaticEnum<EMetaHumanGenerationFailure>()->GetNameStringByValue(static_cast<int64>(Reason))));
+	TransitionToState(Job, EBatchGenState::Error);
+}
+
+bool UEditorBatchGenerationSubsystem::IsRetryableFailure(EMetaHumanGenerationFailure Reason)
+{
+	switch (Reason)
+	{
+		case EMetaHumanGenerationFailure::Auth:
+		case EMetaHumanGenerationFailure::Create:
+		case EMetaHumanGenerationFailure::Rig:
+		case EMetaHumanGenerationFailure::Texture:
+		case EMetaHumanGenerationFailure::Assemble:
+			return true;
+		default:
+			// Configure/Wardrobe failures come from the entry itself and would fail again
+			return false;
+	}
+}
+
+float UEditorBatchGenerationSubsystem::GetRetryDelay(int32 RetryCount) const
+{
+	const float Delay = FMath::Min(RetryMaxDelayConfig, RetryBaseDelayConfig * FMath::Pow(2.0f, RetryCount));
+	return Delay * FMath::FRandRange(0.75f, 1.25f);
+}
+
+void UEditorBatchGenerationSubsystem::AddDeadLetter(const FBatchGenerationJob& Job)
+{
+	FBatchGenerationDeadLetter& DeadLetter = DeadLetters.AddDefaulted_GetRef();
+	DeadLetter.JobId = Job.JobId;
+	DeadLetter.ManifestEntry = Job.ManifestEntry;
+	DeadLetter.CharacterName = Job.CharacterName;
+	DeadLetter.FailureReason = Job.FailureReason;
+	DeadLetter.ErrorMessage = Job.LastErrorMessage;
+	DeadLetter.Attempts = Job.RetryCount + 1;
+	DeadLetter.Timestamp = FDateTime::Now();
+
+	UE_LOG(LogTemp, Error, TEXT("EditorBatchGenerationSubsystem: Job %d dead-lettered after %d attempt(s) (entry %d, seed %d)"),
+		Job.JobId, DeadLetter.Attempts, Job.ManifestEntry.Index, Job.ManifestEntry.Seed);
+
+	// One JSON object per line, so the file can be replayed as a manifest of failed entries
+	FString Line;
+	if (FJsonObjectConverter::UStructToJsonObjectString(DeadLetter, Line, 0, 0, 0, nullptr, false))
+	{
+		const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("DeadLetters"),
+			FString::Printf(TEXT("DeadLetters_%s.jsonl"), *GetBatchFileTag()));
+		FFileHelper::SaveStringToFile(Line + TEXT("\n"), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+			&IFileManager::Get(), FILEWRITE_Append);
 	}
+}
 
-	// Generate character name based on ethnicity and gender
-	FDateTime Now = FDateTime::Now();
-	FString GenderCode = bIsFemale ? TEXT("F") : TEXT("M");
+// ============================================================================
+// Completion Events
+// ============================================================================
 
-	OutCharacterName = FString::Printf(TEXT("%s-%s-BatchGen-%02d%02d_%02d%02d%02d"),
-		*EthnicityCode,
-		*GenderCode,
-		Now.GetMonth(), Now.GetDay(),
-		Now.GetHour(), Now.GetMinute(), Now.GetSecond());
+void UEditorBatchGenerationSubsystem::BindCompletionEvents()
+{
+	if (RiggingStateChangedHandle.IsValid())
+		return;
 
-	// Log the character info for debugging
-	UE_LOG(LogTemp, Log, TEXT("Generated character: %s (Ethnicity: %s, Gender: %s)"),
-		*OutCharacterName, *EthnicityCode, bIsFemale ? TEXT("Female") : TEXT("Male"));
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>() : nullptr;
+	if (!EditorSubsystem)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EditorBatchGenerationSubsystem: MetaHumanCharacterEditorSubsystem not available, relying on watchdog polling"));
+		return;
+	}
+
+	RiggingStateChangedHandle = EditorSubsystem->OnRiggingStateChanged.AddUObject(
+		this, &UEditorBatchGenerationSubsystem::HandleRiggingStateChanged);
+}
+
+void UEditorBatchGenerationSubsystem::UnbindCompletionEvents()
+{
+	if (!RiggingStateChangedHandle.IsValid())
+		return;
+
+	if (UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>() : nullptr)
+	{
+		EditorSubsystem->OnRiggingStateChanged.Remove(RiggingStateChangedHandle);
+	}
+	RiggingStateChangedHandle.Reset();
 }
 
+void UEditorBatchGenerationSubsystem::HandleRiggingStateChanged(TNotNull<const UMetaHumanCharacter*> InCharacter, EMetaHumanCharacterRigState NewState)
+{
+	const UMetaHumanCharacter* ChangedCharacter = InCharacter;
 
+	// Only flag the job here - the transition itself happens on the next ticker frame,
+	// outside of the editor subsystem's broadcast
+	for (FBatchGenerationJob& Job : Jobs)
+	{
+		if (Job.Character.Get() == ChangedCharacter && Job.State == EBatchGenState::WaitingForRig)
+		{
+			UE_LOG(LogTemp, Log, TEXT("EditorBatchGenerationSubsystem: Job %d: Rigging state changed to %s"),
+				Job.JobId, *UEnum::GetValueAsString(NewState));
+			Job.bRigStateChanged = true;
+			break;
+		}
+	}
+}
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Appearance Transaction - Implementation
+
+#include "MetaHumanAppearanceTransaction.h"
+#include "MetaHumanCharacterEditorSubsystem.h"
+#include "Editor.h"
+
+namespace MetaHumanAppearanceTransaction
+{
+	/** Property-wise comparison, the settings structs have no operator== */
+	template <typename SettingsType>
+	static bool IsUnchanged(const SettingsType& Staged, const SettingsType& Current)
+	{
+		return SettingsType::StaticStruct()->CompareScriptStruct(&Staged, &Current, PPF_None);
+	}
+}
+
+FMetaHumanAppearanceTransaction::FMetaHumanAppearanceTransaction(UMetaHumanCharacter* InCharacter)
+	: Character(InCharacter)
+{
+}
+
+void FMetaHumanAppearanceTransaction::StageSkin(const FMetaHumanCharacterSkinSettings& SkinSettings)
+{
+	StagedSkin = SkinSettings;
+}
+
+void FMetaHumanAppearanceTransaction::StageEyes(const FMetaHumanCharacterEyesSettings& EyesSettings)
+{
+	StagedEyes = EyesSettings;
+}
+
+void FMetaHumanAppearanceTransaction::StageHeadModel(const FMetaHumanCharacterHeadModelSettings& HeadModelSettings)
+{
+	StagedHeadModel = HeadModelSettings;
+}
+
+bool FMetaHumanAppearanceTransaction::Commit()
+{
+	using namespace MetaHumanAppearanceTransaction;
+
+	NumCommitted = 0;
+	NumSkipped = 0;
+
+	UMetaHumanCharacter* TargetCharacter = Character.Get();
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>() : nullptr;
+	if (!TargetCharacter || !EditorSubsystem)
+	{
+		StagedSkin.Reset();
+		StagedEyes.Reset();
+		StagedHeadModel.Reset();
+		return false;
+	}
+
+	// Eyes and head model first: cheap material updates. The skin goes last, its texture synthesis is the expensive part
+	if (StagedEyes.IsSet())
+	{
+		if (IsUnchanged(StagedEyes.GetValue(), TargetCharacter->EyesSettings))
+		{
+			++NumSkipped;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("  - Applying eyes settings..."));
+			EditorSubsystem->ApplyEyesSettings(TargetCharacter, StagedEyes.GetValue());
+			EditorSubsystem->CommitEyesSettings(TargetCharacter, StagedEyes.GetValue());
+			++NumCommitted;
+		}
+	}
+
+	if (StagedHeadModel.IsSet())
+	{
+		if (IsUnchanged(StagedHeadModel.GetValue(), TargetCharacter->HeadModelSettings))
+		{
+			++NumSkipped;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("  - Applying head model settings..."));
+			EditorSubsystem->ApplyHeadModelSettings(TargetCharacter, StagedHeadModel.GetValue());
+			EditorSubsystem->CommitHeadModelSettings(TargetCharacter, StagedHeadModel.GetValue());
+			++NumCommitted;
+		}
+	}
+
+	if (StagedSkin.IsSet())
+	{
+		if (IsUnchanged(StagedSkin.GetValue(), TargetCharacter->SkinSettings))
+		{
+			++NumSkipped;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("  - Applying skin settings..."));
+			EditorSubsystem->ApplySkinSettings(TargetCharacter, StagedSkin.GetValue());
+			EditorSubsystem->CommitSkinSettings(TargetCharacter, StagedSkin.GetValue());
+			++NumCommitted;
+		}
+	}
+
+	StagedSkin.Reset();
+	StagedEyes.Reset();
+	StagedHeadModel.Reset();
+
+	if (NumSkipped > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  - %d appearance group(s) unchanged, not regenerated"), NumSkipped);
+	}
+	return true;
+}
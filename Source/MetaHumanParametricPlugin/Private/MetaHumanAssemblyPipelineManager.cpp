@@ -11,6 +11,29 @@
 #include "MetaHumanCollectionPipeline.h"
 #include "MetaHumanCollectionEditorPipeline.h"
 #include "Subsystem/MetaHumanCharacterBuild.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace MetaHumanPipelineCache
+{
+	struct FEntry
+	{
+		/** Settings entry the class was resolved from, compared against the settings on every lookup */
+		TSoftClassPtr<UMetaHumanCollectionPipeline> PipelineClassPtr;
+
+		/** Keeps the class loaded - nothing else references it between characters */
+		TStrongObjectPtr<UClass> PipelineClass;
+	};
+
+	/** Keyed by MakeKey(QualityLevel, bUseUEFNPipeline) */
+	static TMap<uint32, FEntry> Entries;
+
+	static FMetaHumanPipelineCacheStats Stats;
+
+	static uint32 MakeKey(EMetaHumanQualityLevel QualityLevel, bool bUseUEFNPipeline)
+	{
+		return (static_cast<uint32>(QualityLevel) << 1) | (bUseUEFNPipeline ? 1u : 0u);
+	}
+}
 
 // ============================================================================
 // Main Assembly Function
@@ -100,32 +123,59 @@ UMetaHumanCollectionPipeline* UMetaHumanAssemblyPipelineManager::GetDefaultPipel
 		PipelineClassPtr = Settings->DefaultCharacterLegacyPipelines[QualityLevel];
 	}
 
-	if (!PipelineClassPtr.IsValid())
+	using namespace MetaHumanPipelineCache;
+
+	// Only the class is shared - an instance carries per-build state, so every character gets a new one
+	FEntry& Entry = Entries.FindOrAdd(MakeKey(QualityLevel, bUseUEFNPipeline));
+	const bool bHit = IsValid(Entry.PipelineClass.Get()) && Entry.PipelineClassPtr == PipelineClassPtr;
+
+	const double StartTime = FPlatformTime::Seconds();
+	UClass* PipelineClass = bHit ? Entry.PipelineClass.Get() : PipelineClassPtr.LoadSynchronous();
+	if (!PipelineClass)
 	{
-		UClass* PipelineClass = PipelineClassPtr.LoadSynchronous();
-		if (!PipelineClass)
-		{
-			UE_LOG(LogTemp, Error, TEXT("[AssemblyPipeline] Failed to load pipeline class for quality level: %s"),
-				*UEnum::GetValueAsString(QualityLevel));
-			return nullptr;
-		}
+		UE_LOG(LogTemp, Error, TEXT("[AssemblyPipeline] Failed to load pipeline class for quality level: %s"),
+			*UEnum::GetValueAsString(QualityLevel));
+		return nullptr;
 	}
+	const double LoadedTime = FPlatformTime::Seconds();
 
-	// Create a new instance of the pipeline
 	UMetaHumanCollectionPipeline* Pipeline = NewObject<UMetaHumanCollectionPipeline>(
 		GetTransientPackage(),
-		PipelineClassPtr.LoadSynchronous());
+		PipelineClass);
 
 	if (!Pipeline)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[AssemblyPipeline] Failed to create pipeline instance"));
 		return nullptr;
 	}
+	Stats.InstantiateSeconds += FPlatformTime::Seconds() - LoadedTime;
+
+	if (bHit)
+	{
+		Stats.Hits++;
+		return Pipeline;
+	}
+
+	Entry.PipelineClassPtr = PipelineClassPtr;
+	Entry.PipelineClass.Reset(PipelineClass);
+	Stats.Misses++;
+	Stats.ClassLoadSeconds += LoadedTime - StartTime;
 
-	UE_LOG(LogTemp, Log, TEXT("[AssemblyPipeline] Created pipeline: %s"), *Pipeline->GetClass()->GetName());
+	UE_LOG(LogTemp, Log, TEXT("[AssemblyPipeline] Loaded pipeline class: %s (%.1f ms)"),
+		*PipelineClass->GetName(), (LoadedTime - StartTime) * 1000.0);
 	return Pipeline;
 }
 
+void UMetaHumanAssemblyPipelineManager::ResetPipelineCache()
+{
+	MetaHumanPipelineCache::Entries.Reset();
+}
+
+FMetaHumanPipelineCacheStats UMetaHumanAssemblyPipelineManager::GetPipelineCacheStats()
+{
+	return MetaHumanPipelineCache::Stats;
+}
+
 bool UMetaHumanAssemblyPipelineManager::CanBuildCharacter(
 	UMetaHumanCharacter* Character,
 	FText& OutErrorMessage)
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Atomic File - Implementation
+
+#include "MetaHumanAtomicFile.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+
+bool FMetaHumanAtomicFile::Write(const FString& FilePath, TFunctionRef<bool(const FString& TempFilePath)> WriteTempFile, bool bFailIfExists)
+{
+	const FString TempFilePath = GetTempFilePath(FilePath);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!WriteTempFile(TempFilePath))
+	{
+		PlatformFile.DeleteFile(*TempFilePath);
+		return false;
+	}
+
+	// MoveFile does not replace an existing target on Win64 (the only platform of this plugin),
+	// which makes exclusive creation a single atomic rename
+	const bool bMoved = bFailIfExists
+		? PlatformFile.MoveFile(*FilePath, *TempFilePath)
+		: IFileManager::Get().Move(*FilePath, *TempFilePath, true, true);
+
+	if (!bMoved)
+	{
+		PlatformFile.DeleteFile(*TempFilePath);
+	}
+	return bMoved;
+}
+
+bool FMetaHumanAtomicFile::SaveString(const FString& Content, const FString& FilePath, bool bFailIfExists)
+{
+	return Write(FilePath, [&Content](const FString& TempFilePath)
+	{
+		return FFileHelper::SaveStringToFile(Content, *TempFilePath);
+	}, bFailIfExists);
+}
+
+bool FMetaHumanAtomicFile::SaveStringArray(const TArray<FString>& Lines, const FString& FilePath)
+{
+	return Write(FilePath, [&Lines](const FString& TempFilePath)
+	{
+		return FFileHelper::SaveStringArrayToFile(Lines, *TempFilePath);
+	});
+}
+
+bool FMetaHumanAtomicFile::SaveArray(const TArray<uint8>& Data, const FString& FilePath)
+{
+	return Write(FilePath, [&Data](const FString& TempFilePath)
+	{
+		return FFileHelper::SaveArrayToFile(Data, *TempFilePath);
+	});
+}
+
+FString FMetaHumanAtomicFile::GetTempFilePath(const FString& FilePath)
+{
+	return FString::Printf(TEXT("%s.%u.tmp"), *FilePath, FPlatformProcess::GetCurrentProcessId());
+}
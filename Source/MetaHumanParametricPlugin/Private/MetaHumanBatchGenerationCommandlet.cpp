@@ -0,0 +1,265 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Generation Commandlet - Implementation
+
+#include "MetaHumanBatchGenerationCommandlet.h"
+#include "EditorBatchGenerationSubsystem.h"
+#include "MetaHumanBatchPlanner.h"
+#include "AssetCompilingManager.h"
+#include "Containers/Ticker.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/ThreadManager.h"
+#include "Editor.h"
+
+UMetaHumanBatchGenerationCommandlet::UMetaHumanBatchGenerationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	HelpDescription = TEXT("Generate a batch of MetaHuman characters without the interactive editor");
+	HelpUsage = TEXT("<Project> -run=MetaHumanBatchGeneration [-Manifest=<file>] [-Count=<n>] [-Seed=<n>] [-OutputPath=<path>] [-Quality=<level>[,<level>...]] [-MaxConcurrent=<n>] [-VariantsPerRig=<n>] [-NoRigCache] [-NoTextureCache] [-TextureCacheMB=<n>] [-TextureResolution=<res>] [-PreviewBuild] [-NoWardrobePreload] [-NoPrototype] [-GCInterval=<n>] [-NoAsyncSave] [-Shared] [-Instance=<name>]");
+
+	HelpParamNames.Add(TEXT("Manifest"));
+	HelpParamDescriptions.Add(TEXT("JSON Lines manifest written by UMetaHumanBatchPlanner (takes precedence over -Count/-Seed)"));
+	HelpParamNames.Add(TEXT("Count"));
+	HelpParamDescriptions.Add(TEXT("Number of characters to plan when no manifest is given"));
+	HelpParamNames.Add(TEXT("Seed"));
+	HelpParamDescriptions.Add(TEXT("Batch seed used with -Count (default: derived from the current time)"));
+	HelpParamNames.Add(TEXT("OutputPath"));
+	HelpParamDescriptions.Add(TEXT("Content path for the generated assets (default: /Game/MetaHumans)"));
+	HelpParamNames.Add(TEXT("Quality"));
+	HelpParamDescriptions.Add(TEXT("EMetaHumanQualityLevel name, e.g. Cinematic, High, Medium, Low (default: Cinematic). A comma separated list assembles every rig at each level, into <OutputPath>/<Level>"));
+	HelpParamNames.Add(TEXT("MaxConcurrent"));
+	HelpParamDescriptions.Add(TEXT("Characters kept in flight at once (default: 4)"));
+	HelpParamNames.Add(TEXT("VariantsPerRig"));
+	HelpParamDescriptions.Add(TEXT("Characters assembled from each AutoRig result with re-drawn hair, clothing and colors (default: 1)"));
+	HelpParamNames.Add(TEXT("NoRigCache"));
+	HelpParamDescriptions.Add(TEXT("Always run AutoRig, even for faces whose rig is in Saved/MetaHumanGeneration/RigCache"));
+	HelpParamNames.Add(TEXT("NoTextureCache"));
+	HelpParamDescriptions.Add(TEXT("Always download high-resolution textures, even if they are in Saved/MetaHumanGeneration/TextureCache"));
+	HelpParamNames.Add(TEXT("TextureCacheMB"));
+	HelpParamDescriptions.Add(TEXT("Size limit of the texture cache, least recently used entries are evicted first (default: 8192)"));
+	HelpParamNames.Add(TEXT("TextureResolution"));
+	HelpParamDescriptions.Add(TEXT("EMetaHumanTextureResolution name: None, Res2k, Res4k, Res8k (default: FromQuality - 2k for Cinematic and High, none for Medium and Low)"));
+	HelpParamNames.Add(TEXT("PreviewBuild"));
+	HelpParamDescriptions.Add(TEXT("Still run the editor preview build of characters without clothing (skipped by default, nothing displays it here; clothing always needs it for Chaos cloth)"));
+	HelpParamNames.Add(TEXT("NoWardrobePreload"));
+	HelpParamDescriptions.Add(TEXT("Load wardrobe items on first use instead of streaming the whole catalog in at startup"));
+	HelpParamNames.Add(TEXT("NoPrototype"));
+	HelpParamDescriptions.Add(TEXT("Initialize every character from scratch instead of copying an initialized prototype"));
+	HelpParamNames.Add(TEXT("GCInterval"));
+	HelpParamDescriptions.Add(TEXT("Collect garbage after every n finished characters, 0 leaves it to the engine (default: 8)"));
+	HelpParamNames.Add(TEXT("NoAsyncSave"));
+	HelpParamDescriptions.Add(TEXT("Wait for every assembled package to be written instead of writing them while the next characters are prepared"));
+	HelpParamNames.Add(TEXT("Shared"));
+	HelpParamDescriptions.Add(TEXT("Claim entries through the on-disk queue of the batch, so several processes can work on it (requires -Seed or -Manifest)"));
+	HelpParamNames.Add(TEXT("Instance"));
+	HelpParamDescriptions.Add(TEXT("Worker name of a shared batch, its shared assets go to <OutputPath>/Common_<name>. Must differ between processes running at the same time, keep it across restarts (default: the host name)"));
+}
+
+int32 UMetaHumanBatchGenerationCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogTemp, Display, TEXT("MetaHumanBatchGenerationCommandlet: %s"), *Params);
+
+	// ============================================================================
+	// Arguments
+	// ============================================================================
+
+	FString ManifestPath;
+	FParse::Value(*Params, TEXT("Manifest="), ManifestPath);
+
+	int32 Count = 0;
+	FParse::Value(*Params, TEXT("Count="), Count);
+
+	int32 BatchSeed = static_cast<int32>(GetTypeHash(FDateTime::Now().GetTicks()));
+	const bool bHasSeed = FParse::Value(*Params, TEXT("Seed="), BatchSeed);
+
+	const bool bShared = FParse::Param(*Params, TEXT("Shared"));
+
+	FString OutputPath = TEXT("/Game/MetaHumans");
+	FParse::Value(*Params, TEXT("OutputPath="), OutputPath);
+
+	int32 MaxConcurrent = 4;
+	FParse::Value(*Params, TEXT("MaxConcurrent="), MaxConcurrent);
+
+	int32 VariantsPerRig = 1;
+	FParse::Value(*Params, TEXT("VariantsPerRig="), VariantsPerRig);
+
+	// The first level is the batch's own, the others are assembled from the same rig
+	EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic;
+	TArray<EMetaHumanQualityLevel> ExtraQualityLevels;
+	FString QualityList;
+	if (FParse::Value(*Params, TEXT("Quality="), QualityList, /*bShouldStopOnSeparator*/ false))
+	{
+		TArray<FString> QualityNames;
+		QualityList.ParseIntoArray(QualityNames, TEXT(","));
+		for (int32 NameIndex = 0; NameIndex < QualityNames.Num(); ++NameIndex)
+		{
+			const FString QualityName = QualityNames[NameIndex].TrimStartAndEnd();
+			const int64 QualityValue = StaticEnum<EMetaHumanQualityLevel>()->GetValueByNameString(QualityName);
+			if (QualityValue == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Unknown quality level '%s'"), *QualityName);
+				return 2;
+			}
+
+			if (NameIndex == 0)
+			{
+				QualityLevel = static_cast<EMetaHumanQualityLevel>(QualityValue);
+			}
+			else
+			{
+				ExtraQualityLevels.Add(static_cast<EMetaHumanQualityLevel>(QualityValue));
+			}
+		}
+	}
+
+	EMetaHumanTextureResolution TextureResolution = EMetaHumanTextureResolution::FromQuality;
+	FString TextureResolutionName;
+	if (FParse::Value(*Params, TEXT("TextureResolution="), TextureResolutionName))
+	{
+		const int64 TextureResolutionValue = StaticEnum<EMetaHumanTextureResolution>()->GetValueByNameString(TextureResolutionName);
+		if (TextureResolutionValue == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Unknown texture resolution '%s'"), *TextureResolutionName);
+			return 2;
+		}
+		TextureResolution = static_cast<EMetaHumanTextureResolution>(TextureResolutionValue);
+	}
+
+	if (ManifestPath.IsEmpty() && Count <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Either -Manifest=<file> or -Count=<n> is required"));
+		UE_LOG(LogTemp, Display, TEXT("Usage: %s"), *HelpUsage);
+		return 2;
+	}
+
+	// Workers find each other through the batch seed, a time-derived one would give every process its own queue
+	if (bShared && ManifestPath.IsEmpty() && !bHasSeed)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: -Shared needs -Seed=<n> or -Manifest=<file>"));
+		return 2;
+	}
+
+	UEditorBatchGenerationSubsystem* BatchSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorBatchGenerationSubsystem>() : nullptr;
+	if (!BatchSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Failed to get batch generation subsystem"));
+		return 2;
+	}
+
+	// ============================================================================
+	// Start the batch
+	// ============================================================================
+
+	FMetaHumanBatchManifest Manifest;
+	if (!ManifestPath.IsEmpty())
+	{
+		if (!UMetaHumanBatchPlanner::LoadManifestFromFile(ManifestPath, Manifest))
+		{
+			UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Failed to load manifest: %s"), *ManifestPath);
+			return 2;
+		}
+	}
+	else
+	{
+		Manifest = UMetaHumanBatchPlanner::PlanBatch(BatchSeed, Count);
+	}
+
+	BatchSubsystem->SetVariantsPerRig(VariantsPerRig);
+	BatchSubsystem->SetRigCacheEnabled(!FParse::Param(*Params, TEXT("NoRigCache")));
+	BatchSubsystem->SetPreviewBuildEnabled(FParse::Param(*Params, TEXT("PreviewBuild")));
+	BatchSubsystem->SetWardrobePreloadEnabled(!FParse::Param(*Params, TEXT("NoWardrobePreload")));
+	BatchSubsystem->SetCharacterPrototypeEnabled(!FParse::Param(*Params, TEXT("NoPrototype")));
+
+	int32 GCInterval = 8;
+	FParse::Value(*Params, TEXT("GCInterval="), GCInterval);
+	BatchSubsystem->SetGarbageCollectionInterval(GCInterval);
+	BatchSubsystem->SetAsyncSaveEnabled(!FParse::Param(*Params, TEXT("NoAsyncSave")));
+
+	FString WorkerInstance;
+	FParse::Value(*Params, TEXT("Instance="), WorkerInstance);
+	BatchSubsystem->SetWorkerInstance(WorkerInstance);
+
+	int32 TextureCacheMB = 8192;
+	FParse::Value(*Params, TEXT("TextureCacheMB="), TextureCacheMB);
+	BatchSubsystem->SetTextureCache(!FParse::Param(*Params, TEXT("NoTextureCache")), TextureCacheMB);
+	BatchSubsystem->SetTextureResolution(TextureResolution);
+	BatchSubsystem->SetExtraQualityLevels(ExtraQualityLevels);
+	if (bShared)
+	{
+		BatchSubsystem->StartSharedBatchGeneration(Manifest, OutputPath, QualityLevel, 2.0f, MaxConcurrent);
+	}
+	else
+	{
+		BatchSubsystem->StartBatchGenerationFromManifest(Manifest, OutputPath, QualityLevel, 2.0f, MaxConcurrent);
+	}
+
+	if (!BatchSubsystem->IsRunning())
+	{
+		UE_LOG(LogTemp, Error, TEXT("MetaHumanBatchGenerationCommandlet: Batch did not start"));
+		return 2;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("MetaHumanBatchGenerationCommandlet: Batch %d started (%s%s, %d concurrent%s) -> %s"),
+		BatchSubsystem->GetBatchSeed(), *UEnum::GetValueAsString(QualityLevel),
+		ExtraQualityLevels.Num() > 0 ? *FString::Printf(TEXT(" +%d level(s)"), ExtraQualityLevels.Num()) : TEXT(""), MaxConcurrent,
+		bShared ? TEXT(", shared queue") : TEXT(""), *OutputPath);
+
+	// ============================================================================
+	// Main loop - no viewport or Slate, so only the tickers the state machine relies on are pumped
+	// ============================================================================
+
+	double LastTime = FPlatformTime::Seconds();
+	while (BatchSubsystem->IsRunning())
+	{
+		if (IsEngineExitRequested())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MetaHumanBatchGenerationCommandlet: Exit requested, stopping batch"));
+			BatchSubsystem->StopBatchGeneration();
+			break;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		TickEngine(static_cast<float>(Now - LastTime));
+		LastTime = Now;
+
+		// Nothing renders, so there is no frame pacing - just avoid spinning while jobs wait on the cloud
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	// ============================================================================
+	// Summary
+	// ============================================================================
+
+	EBatchGenState State;
+	FString CharacterName;
+	int32 GeneratedCount = 0;
+	FMetaHumanBatchMetricsSnapshot Metrics;
+	BatchSubsystem->GetStatusInfo(State, CharacterName, GeneratedCount, Metrics);
+
+	TArray<FBatchGenerationDeadLetter> DeadLetters;
+	BatchSubsystem->GetDeadLetters(DeadLetters);
+
+	UE_LOG(LogTemp, Display, TEXT("MetaHumanBatchGenerationCommandlet: Done - %d generated, %d failed in %.1f s (%.1f characters/hour)"),
+		GeneratedCount, DeadLetters.Num(), Metrics.ElapsedSeconds, Metrics.CharactersPerHour);
+
+	return DeadLetters.Num() > 0 ? 1 : 0;
+}
+
+void UMetaHumanBatchGenerationCommandlet::TickEngine(float DeltaTime)
+{
+	// Game thread tasks (AsyncTask callbacks, cloud request completions)
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+	// Batch state machine, heartbeat and the MetaHuman editor's own tickers
+	FTSTicker::GetCoreTicker().Tick(DeltaTime);
+	FThreadManager::Get().Tick();
+
+	// Texture and mesh compilation kicked off by assembly
+	FAssetCompilingManager::Get().ProcessAsyncTasks(true);
+
+	GEngine->TickDeferredCommands();
+}
@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Job Queue - Implementation
+
+#include "MetaHumanBatchJobQueue.h"
+#include "MetaHumanAtomicFile.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+TSharedPtr<FMetaHumanBatchJobQueue> FMetaHumanBatchJobQueue::OpenOrCreate(const FMetaHumanBatchManifest& InManifest, const FString& InQueueDirectory)
+{
+	TSharedPtr<FMetaHumanBatchJobQueue> Queue = MakeShareable(new FMetaHumanBatchJobQueue());
+	Queue->QueueDirectory = InQueueDirectory.IsEmpty() ? GetDefaultQueueDirectory(InManifest.BatchSeed) : InQueueDirectory;
+	Queue->WorkerId = GetLocalWorkerId();
+
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FileManager.MakeDirectory(*FPaths::Combine(Queue->QueueDirectory, TEXT("Leases")), true)
+		|| !FileManager.MakeDirectory(*FPaths::Combine(Queue->QueueDirectory, TEXT("Done")), true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchQueue] Failed to create queue directory: %s"), *Queue->QueueDirectory);
+		return nullptr;
+	}
+
+	// The first worker publishes its manifest, everyone else adopts the published one
+	const FString ManifestPath = FPaths::Combine(Queue->QueueDirectory, TEXT("Manifest.json"));
+	FString ManifestJson;
+	if (FJsonObjectConverter::UStructToJsonObjectString(InManifest, ManifestJson)
+		&& FMetaHumanAtomicFile::SaveString(ManifestJson, ManifestPath, /*bFailIfExists*/ true))
+	{
+		Queue->Manifest = InManifest;
+		UE_LOG(LogTemp, Log, TEXT("[BatchQueue] Published batch %d (%d entries) at %s"),
+			InManifest.BatchSeed, InManifest.Entries.Num(), *Queue->QueueDirectory);
+	}
+	else if (!FFileHelper::LoadFileToString(ManifestJson, *ManifestPath)
+		|| !FJsonObjectConverter::JsonObjectStringToUStruct(ManifestJson, &Queue->Manifest))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchQueue] Failed to read the published manifest: %s"), *ManifestPath);
+		return nullptr;
+	}
+	else
+	{
+		if (Queue->Manifest.Entries.Num() != InManifest.Entries.Num())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[BatchQueue] Queue already holds %d entries, ignoring the %d requested"),
+				Queue->Manifest.Entries.Num(), InManifest.Entries.Num());
+		}
+		UE_LOG(LogTemp, Log, TEXT("[BatchQueue] Joined batch %d (%d entries) at %s"),
+			Queue->Manifest.BatchSeed, Queue->Manifest.Entries.Num(), *Queue->QueueDirectory);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BatchQueue] Worker id: %s"), *Queue->WorkerId);
+	return Queue;
+}
+
+FString FMetaHumanBatchJobQueue::GetDefaultQueueDirectory(int32 BatchSeed)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("Queue"), FString::FromInt(BatchSeed));
+}
+
+FString FMetaHumanBatchJobQueue::GetLocalWorkerId()
+{
+	return FString::Printf(TEXT("%s-%u"), FPlatformProcess::ComputerName(), FPlatformProcess::GetCurrentProcessId());
+}
+
+// ============================================================================
+// Claiming
+// ============================================================================
+
+bool FMetaHumanBatchJobQueue::TryClaimNext(FMetaHumanBatchManifestEntry& OutEntry)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	const int32 NumEntries = Manifest.Entries.Num();
+
+	// Start where the last claim stopped so finished entries are not rescanned on every call
+	for (int32 Step = 0; Step < NumEntries; ++Step)
+	{
+		const int32 Slot = (ClaimCursor + Step) % NumEntries;
+		const int32 Index = Manifest.Entries[Slot].Index;
+
+		if (OwnedLeases.Contains(Index) || IsDone(Index))
+		{
+			continue;
+		}
+
+		if (FileManager.FileExists(*GetLeasePath(Index)) && !TryBreakExpiredLease(Index))
+		{
+			continue;
+		}
+
+		if (!CreateLease(Index))
+		{
+			// Another worker claimed it first
+			continue;
+		}
+
+		// The previous owner may have finished between the done check and the claim
+		if (IsDone(Index))
+		{
+			FileManager.Delete(*GetLeasePath(Index));
+			continue;
+		}
+
+		OwnedLeases.Add(Index);
+		ClaimCursor = (Slot + 1) % NumEntries;
+		OutEntry = Manifest.Entries[Slot];
+
+		UE_LOG(LogTemp, Log, TEXT("[BatchQueue] Claimed entry %d"), Index);
+		return true;
+	}
+
+	return false;
+}
+
+bool FMetaHumanBatchJobQueue::RenewLease(int32 Index)
+{
+	// Touch first, then check the owner: the file is never replaced, so a claimer racing with the
+	// renewal either sees the fresh timestamp or has already put its own lease in place, which
+	// the owner check below catches (touching a stranger's lease only extends it a little)
+	const bool bTouched = IFileManager::Get().SetTimeStamp(*GetLeasePath(Index), FDateTime::UtcNow());
+
+	FMetaHumanBatchJobLease Lease;
+	if (!bTouched || !ReadLease(Index, Lease) || Lease.WorkerId != WorkerId)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[BatchQueue] Lost the lease of entry %d (now held by %s)"),
+			Index, Lease.WorkerId.IsEmpty() ? TEXT("nobody") : *Lease.WorkerId);
+		OwnedLeases.Remove(Index);
+		return false;
+	}
+	return true;
+}
+
+void FMetaHumanBatchJobQueue::ReleaseLease(int32 Index)
+{
+	FMetaHumanBatchJobLease Lease;
+	if (OwnedLeases.Remove(Index) > 0 && ReadLease(Index, Lease) && Lease.WorkerId == WorkerId)
+	{
+		IFileManager::Get().Delete(*GetLeasePath(Index));
+		UE_LOG(LogTemp, Log, TEXT("[BatchQueue] Released entry %d"), Index);
+	}
+}
+
+void FMetaHumanBatchJobQueue::MarkDone(int32 Index, bool bSuccess)
+{
+	FMetaHumanBatchJobDone Done;
+	Done.WorkerId = WorkerId;
+	Done.Index = Index;
+	Done.bSuccess = bSuccess;
+	Done.FinishedUtc = FDateTime::UtcNow();
+
+	// The marker goes first: once it exists nobody starts the entry again, even if the lease is already gone
+	FString DoneJson;
+	if (FJsonObjectConverter::UStructToJsonObjectString(Done, DoneJson))
+	{
+		FMetaHumanAtomicFile::SaveString(DoneJson, GetDonePath(Index), /*bFailIfExists*/ true);
+	}
+	KnownDone.Add(Index);
+
+	ReleaseLease(Index);
+}
+
+bool FMetaHumanBatchJobQueue::IsComplete()
+{
+	for (const FMetaHumanBatchManifestEntry& Entry : Manifest.Entries)
+	{
+		if (!IsDone(Entry.Index))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// ============================================================================
+// Files
+// ============================================================================
+
+FString FMetaHumanBatchJobQueue::GetLeasePath(int32 Index) const
+{
+	return FPaths::Combine(QueueDirectory, TEXT("Leases"), FString::Printf(TEXT("%d.lease"), Index));
+}
+
+FString FMetaHumanBatchJobQueue::GetDonePath(int32 Index) const
+{
+	return FPaths::Combine(QueueDirectory, TEXT("Done"), FString::Printf(TEXT("%d.done"), Index));
+}
+
+bool FMetaHumanBatchJobQueue::IsDone(int32 Index)
+{
+	if (KnownDone.Contains(Index))
+	{
+		return true;
+	}
+
+	if (IFileManager::Get().FileExists(*GetDonePath(Index)))
+	{
+		KnownDone.Add(Index);
+		return true;
+	}
+	return false;
+}
+
+bool FMetaHumanBatchJobQueue::CreateLease(int32 Index) const
+{
+	FMetaHumanBatchJobLease Lease;
+	Lease.WorkerId = WorkerId;
+	Lease.Index = Index;
+	Lease.DurationSeconds = LeaseDurationSeconds;
+
+	FString LeaseJson;
+	return FJsonObjectConverter::UStructToJsonObjectString(Lease, LeaseJson)
+		&& FMetaHumanAtomicFile::SaveString(LeaseJson, GetLeasePath(Index), /*bFailIfExists*/ true);
+}
+
+bool FMetaHumanBatchJobQueue::ReadLease(int32 Index, FMetaHumanBatchJobLease& OutLease) const
+{
+	FString LeaseJson;
+	return FFileHelper::LoadFileToString(LeaseJson, *GetLeasePath(Index))
+		&& FJsonObjectConverter::JsonObjectStringToUStruct(LeaseJson, &OutLease);
+}
+
+FDateTime FMetaHumanBatchJobQueue::GetLeaseExpiry(const FString& LeasePath, const FMetaHumanBatchJobLease& Lease)
+{
+	const FDateTime Modified = IFileManager::Get().GetTimeStamp(*LeasePath);
+	if (Modified == FDateTime::MinValue())
+	{
+		// Gone - treat it as live, the caller re-checks the file anyway
+		return FDateTime::MaxValue();
+	}
+	return Modified + FTimespan::FromSeconds(Lease.DurationSeconds);
+}
+
+bool FMetaHumanBatchJobQueue::TryBreakExpiredLease(int32 Index) const
+{
+	FMetaHumanBatchJobLease Lease;
+	if (!ReadLease(Index, Lease) || GetLeaseExpiry(GetLeasePath(Index), Lease) > FDateTime::UtcNow())
+	{
+		return false;
+	}
+
+	// Renaming the lease away is the atomic part - only one of several workers sees it succeed
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString LeasePath = GetLeasePath(Index);
+	const FString BrokenPath = FString::Printf(TEXT("%s.%s.broken"), *LeasePath, *WorkerId);
+	if (!PlatformFile.MoveFile(*BrokenPath, *LeasePath))
+	{
+		return false;
+	}
+
+	// The owner may have renewed between our read and the rename (the rename keeps the timestamp) - hand its lease back
+	FMetaHumanBatchJobLease MovedLease;
+	FString MovedJson;
+	if (FFileHelper::LoadFileToString(MovedJson, *BrokenPath)
+		&& FJsonObjectConverter::JsonObjectStringToUStruct(MovedJson, &MovedLease)
+		&& GetLeaseExpiry(BrokenPath, MovedLease) > FDateTime::UtcNow())
+	{
+		PlatformFile.MoveFile(*LeasePath, *BrokenPath);
+		PlatformFile.DeleteFile(*BrokenPath);
+		return false;
+	}
+
+	PlatformFile.DeleteFile(*BrokenPath);
+	UE_LOG(LogTemp, Warning, TEXT("[BatchQueue] Took over expired lease of entry %d from %s"), Index, *Lease.WorkerId);
+	return true;
+}
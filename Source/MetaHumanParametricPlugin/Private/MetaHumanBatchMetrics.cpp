@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Metrics - Implementation
+
+#include "MetaHumanBatchMetrics.h"
+#include "MetaHumanAtomicFile.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+void FMetaHumanBatchMetrics::FStageHistogram::Add(double Seconds)
+{
+	int32 BucketIndex = 0;
+	if (Seconds > MinSeconds)
+	{
+		BucketIndex = FMath::FloorToInt32(FMath::Loge(Seconds / MinSeconds) / FMath::Loge(Growth));
+	}
+	Buckets[FMath::Clamp(BucketIndex, 0, NumBuckets - 1)]++;
+
+	TotalSeconds += Seconds;
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+double FMetaHumanBatchMetrics::FStageHistogram::GetPercentile(double Percentile) const
+{
+	const int32 SampleCount = SuccessCount + FailureCount;
+	if (SampleCount == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Rank = FMath::Max<uint32>(1, FMath::CeilToInt32(Percentile * SampleCount));
+	uint32 Seen = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Seen += Buckets[BucketIndex];
+		if (Seen >= Rank)
+		{
+			// Upper edge of the bucket, never above the largest sample we have seen
+			return FMath::Min(MinSeconds * FMath::Pow(Growth, BucketIndex + 1), MaxSeconds);
+		}
+	}
+	return MaxSeconds;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+FMetaHumanBatchMetrics::FMetaHumanBatchMetrics()
+{
+	Reset();
+}
+
+void FMetaHumanBatchMetrics::Reset()
+{
+	StageOrder.Reset();
+	Stages.Reset();
+	Counters.Reset();
+	StartTime = FPlatformTime::Seconds();
+	CharactersCompleted = 0;
+	CharactersFailed = 0;
+	StartUsedPhysical = 0;
+	LastUsedPhysical = 0;
+	PeakUsedPhysical = 0;
+	TotalCollectionMemoryDelta = 0;
+	MaxCollectionMemoryDelta = 0;
+	CollectionMemorySamples = 0;
+	CollectionMemoryJobs = 0;
+	MaxJobMemoryDelta = 0.0;
+}
+
+void FMetaHumanBatchMetrics::RecordStage(FName Stage, double Seconds, bool bSuccess)
+{
+	FStageHistogram* Histogram = Stages.Find(Stage);
+	if (!Histogram)
+	{
+		StageOrder.Add(Stage);
+		Histogram = &Stages.Add(Stage);
+	}
+
+	Histogram->Add(Seconds);
+	if (bSuccess)
+	{
+		Histogram->SuccessCount++;
+	}
+	else
+	{
+		Histogram->FailureCount++;
+	}
+}
+
+void FMetaHumanBatchMetrics::RecordCharacter(bool bSuccess)
+{
+	if (bSuccess)
+	{
+		CharactersCompleted++;
+	}
+	else
+	{
+		CharactersFailed++;
+	}
+}
+
+void FMetaHumanBatchMetrics::IncrementCounter(FName Counter, int64 Delta)
+{
+	Counters.FindOrAdd(Counter) += Delta;
+}
+
+void FMetaHumanBatchMetrics::RecordMemory(uint64 UsedPhysicalBytes)
+{
+	if (StartUsedPhysical == 0)
+	{
+		StartUsedPhysical = UsedPhysicalBytes;
+	}
+	LastUsedPhysical = UsedPhysicalBytes;
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, UsedPhysicalBytes);
+}
+
+void FMetaHumanBatchMetrics::RecordCollectionMemoryDelta(int64 DeltaBytes, int32 NumJobs)
+{
+	const double JobDelta = static_cast<double>(DeltaBytes) / FMath::Max(1, NumJobs);
+	MaxCollectionMemoryDelta = CollectionMemorySamples > 0 ? FMath::Max(MaxCollectionMemoryDelta, DeltaBytes) : DeltaBytes;
+	MaxJobMemoryDelta = CollectionMemorySamples > 0 ? FMath::Max(MaxJobMemoryDelta, JobDelta) : JobDelta;
+	TotalCollectionMemoryDelta += DeltaBytes;
+	CollectionMemorySamples++;
+	CollectionMemoryJobs += FMath::Max(1, NumJobs);
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+FMetaHumanBatchMetricsSnapshot FMetaHumanBatchMetrics::GetSnapshot() const
+{
+	FMetaHumanBatchMetricsSnapshot Snapshot;
+	Snapshot.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	Snapshot.CharactersCompleted = CharactersCompleted;
+	Snapshot.CharactersFailed = CharactersFailed;
+	Snapshot.CharactersPerHour = Snapshot.ElapsedSeconds > 0.0f
+		? CharactersCompleted * 3600.0f / Snapshot.ElapsedSeconds
+		: 0.0f;
+	Snapshot.Counters = Counters;
+
+	constexpr double BytesPerMB = 1024.0 * 1024.0;
+	Snapshot.StartUsedPhysicalMB = StartUsedPhysical / BytesPerMB;
+	Snapshot.UsedPhysicalMB = LastUsedPhysical / BytesPerMB;
+	Snapshot.PeakUsedPhysicalMB = PeakUsedPhysical / BytesPerMB;
+	Snapshot.MeanCollectionMemoryDeltaMB = CollectionMemorySamples > 0 ? TotalCollectionMemoryDelta / BytesPerMB / CollectionMemorySamples : 0.0;
+	Snapshot.MaxCollectionMemoryDeltaMB = MaxCollectionMemoryDelta / BytesPerMB;
+	Snapshot.MeanJobMemoryDeltaMB = CollectionMemoryJobs > 0 ? TotalCollectionMemoryDelta / BytesPerMB / CollectionMemoryJobs : 0.0;
+	Snapshot.MaxJobMemoryDeltaMB = MaxJobMemoryDelta / BytesPerMB;
+
+	for (const FName& Stage : StageOrder)
+	{
+		const FStageHistogram& Histogram = Stages.FindChecked(Stage);
+		const int32 SampleCount = Histogram.SuccessCount + Histogram.FailureCount;
+
+		FMetaHumanStageMetricsSnapshot& StageSnapshot = Snapshot.Stages.AddDefaulted_GetRef();
+		StageSnapshot.Stage = Stage;
+		StageSnapshot.SuccessCount = Histogram.SuccessCount;
+		StageSnapshot.FailureCount = Histogram.FailureCount;
+		StageSnapshot.MeanSeconds = SampleCount > 0 ? Histogram.TotalSeconds / SampleCount : 0.0;
+		StageSnapshot.P50Seconds = Histogram.GetPercentile(0.50);
+		StageSnapshot.P95Seconds = Histogram.GetPercentile(0.95);
+		StageSnapshot.P99Seconds = Histogram.GetPercentile(0.99);
+		StageSnapshot.MaxSeconds = Histogram.MaxSeconds;
+	}
+
+	return Snapshot;
+}
+
+bool FMetaHumanBatchMetrics::WriteToFile(const FString& FilePath) const
+{
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(GetSnapshot(), JsonString))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchMetrics] Failed to serialize metrics"));
+		return false;
+	}
+
+	if (!FMetaHumanAtomicFile::SaveString(JsonString, FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchMetrics] Failed to write metrics to: %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+FString FMetaHumanBatchMetrics::GetDefaultMetricsDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("Metrics"));
+}
@@ -0,0 +1,657 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Planner - Implementation
+
+#include "MetaHumanBatchPlanner.h"
+#include "MetaHumanBodyType.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+// ============================================================================
+// Wardrobe Draws
+// ============================================================================
+
+// Shared by ExpandEntry and ExpandWardrobeVariant. The draw order inside each
+// function is part of the manifest format - changing it changes every character.
+namespace BatchPlannerDraws
+{
+
+// Candidate lists - a character draws from these, the preloader loads all of them
+
+static const TArray<FString> MaleHairPaths = {
+	// 短发
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SlickBack.WI_Hair_S_SlickBack"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SweptUp.WI_Hair_S_SweptUp"),
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_PulledBack.WI_Hair_S_PulledBack"), //狂怒 男主发型
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Messy.WI_Hair_S_Messy"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_HairLoss.WI_Hair_S_HairLoss"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CurlyFade.WI_Hair_S_CurlyFade"),  // 短卷
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CoilBuzzCut.WI_Hair_S_CoilBuzzCut"), //
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BuzzCut.WI_Hair_S_BuzzCut"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BrushCut.WI_Hair_S_BrushCut"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Clean.WI_Hair_S_Clean"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_360Waves.WI_Hair_S_360Waves"),  // 短寸
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Casual.WI_Hair_S_Casual"),  // 商务短发
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Coil.WI_Hair_S_Coil"),
+
+	// 中短发 
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Pixie.WI_Hair_S_Pixie"),  // 类似碎盖 带刘海
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SideSweptFringe.WI_Hair_S_SideSweptFringe"),  // 普通三七分
+
+
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_RecedeMessy.WI_Hair_S_RecedeMessy"),  // 秃
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BaldingStubble.WI_Hair_S_BaldingStubble"), // 更秃
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_AfroFade.WI_Hair_S_AfroFade"),  // 短蓬松卷,
+	
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Mohawk.WI_Hair_M_Mohawk"), // cyber phonk 发型 
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_FauxMohawk.WI_Hair_M_FauxMohawk"), // cyber phonk 发型
+	
+};
+
+static const TArray<FString> FemaleHairPaths = {
+	// 中长发
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_LowPonytail.WI_Hair_S_LowPonytail"), // 类似学生头
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_StraightBangs.WI_Hair_L_StraightBangs"),
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_Straight.WI_Hair_L_Straight"),  // 容易看起来像西方人
+	TEXT("/Game/MHPKG/hair_l_highponytail/WI_Hair_L_HighPonytail.WI_Hair_L_HighPonytail"),
+
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBuns.WI_Hair_S_UpdoBuns"), // 樱桃 短扎
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBraids.WI_Hair_S_UpdoBraids"),  // 樱桃 短扎
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Updo.WI_Hair_S_Updo"), // 樱桃 短扎
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Layered.WI_Hair_M_Layered")  // 西方男生微卷到肩
+
+	// bob 短发系列
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobStraight.WI_Hair_M_BobStraight"), // 直发蘑菇头
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobSlick.WI_Hair_M_BobSlick"),
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobMessy.WI_Hair_M_BobMessy"),  // 
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobCurly.WI_Hair_M_BobCurly"),  // 到肩 微卷
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobBangs.WI_Hair_M_BobBangs"),  // 到颈 哆啦/盖茨比Daisy头
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BobLayered.WI_Hair_S_BobLayered")  // 到颈 微卷
+
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_TwistedBraids.WI_Hair_M_TwistedBraids"), // 脏辫
+
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_MessyClumps.WI_Hair_L_MessyClumps"),  // 指环王精灵女王发型
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_AfroCurly.WI_Hair_L_AfroCurly") //爆炸头
+};
+
+static const TArray<FString> UnisexHairPaths = {
+	
+	
+	
+	// TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Cornrows.WI_Hair_S_Cornrows"), // 脏辫背头
+	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_SideSweptFringe.WI_Hair_M_SideSweptFringe"),  // 颈部长度 三七分 颈后微卷
+	
+	
+};
+
+static const TArray<FString> UpperAndLowerCloth = {
+	TEXT("/MetaHumanCharacter/Optional/Clothing/WI_DefaultGarment.WI_DefaultGarment")
+};
+
+static const TArray<FString> UpperCloth = {
+	// New Ones
+	"/Game/GoodWI/Upper/WI_Puffer_Jacket.WI_Puffer_Jacket", //
+	// "/Game/GoodWI/Upper/WI_Shirts.WI_Shirts",  //下摆太长，容易穿模
+	"/Game/GoodWI/Upper/WI_Sweater.WI_Sweater",
+	"/Game/GoodWI/Upper/WI_Tank_Top.WI_Tank_Top",
+	"/Game/GoodWI/Upper/WI_Track_Suit.WI_Track_Suit",
+
+
+	"/Game/GoodWI/Upper/WI_Red_Shirt.WI_Red_Shirt",
+	"/Game/GoodWI/Upper/WI_SweaterNew.WI_SweaterNew",
+};
+
+static const TArray<FString> LowerCloth = {
+	// New Ones
+	"/Game/GoodWI/Lower/WI_Bonkers.WI_Bonkers",
+	"/Game/GoodWI/Lower/WI_Cargo.WI_Cargo",
+	"/Game/GoodWI/Lower/WI_Jeans.WI_Jeans",
+	"/Game/GoodWI/Lower/WI_Pant.WI_Pant",  // Warning: this may cause collision with UpperCloth
+	"/Game/GoodWI/Lower/WI_Track_Pant.WI_Track_Pant",
+
+	"/Game/GoodWI/Lower/WI_Baggy_Pants.WI_Baggy_Pants",
+	"/Game/GoodWI/Lower/WI_Cyber_Punk_Pants.WI_Cyber_Punk_Pants",
+	"/Game/GoodWI/Lower/WI_Jeans2.WI_Jeans2",
+	"/Game/GoodWI/Lower/WI_Jeans_1.WI_Jeans_1",
+	"/Game/GoodWI/Lower/WI_Jeans_3.WI_Jeans_3",
+	"/Game/GoodWI/Lower/WI_Colorful_Sweats.WI_Colorful_Sweats",
+};
+
+static const TArray<FString> Shoes = {
+	"/Game/GoodWI/Shoes/WI_Short_Boots.WI_Short_Boots"
+};
+
+static const TArray<FString> FullSuit = { };
+
+static const TArray<FString> OtherItems = {
+	"/Game/GoodWI/OtherItems/WI_Bag.WI_Bag"
+};
+
+/** Hair material parameters and garment colors */
+static void DrawWardrobeColors(FRandomStream& Stream, FMetaHumanWardrobeConfig& Wardrobe)
+{
+	// Wardrobe.HairParameters->Redness = Stream.FRandRange(0.0f, 1.0f);
+	Wardrobe.HairParameters->Roughness = Stream.FRandRange(0.0f, 1.0f);
+	Wardrobe.HairParameters->Whiteness = Stream.FRandRange(0.0f, 1.0f);
+	Wardrobe.HairParameters->Lightness = Stream.FRandRange(0.0f, 1.0f);
+
+	// Randomize wardrobe colors
+	Wardrobe.ColorConfig.PrimaryColorShirt = FLinearColor(
+		Stream.FRandRange(0.0f, 1.0f),  // R
+		Stream.FRandRange(0.0f, 1.0f),  // G
+		Stream.FRandRange(0.0f, 1.0f),  // B
+		1.0f  // A
+	);
+	Wardrobe.ColorConfig.PrimaryColorShort = FLinearColor(
+		Stream.FRandRange(0.0f, 1.0f),  // R
+		Stream.FRandRange(0.0f, 1.0f),  // G
+		Stream.FRandRange(0.0f, 1.0f),  // B
+		1.0f  // A
+	);
+}
+
+static FString DrawHairPath(FRandomStream& Stream, bool bIsFemale)
+{
+	// {
+	// 	// random hair from UE Metahuman Plugin Content
+	// 	FString BaseHairPath = TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair");
+	// 	FString RandomHairItem = UMetaHumanParametricGenerator::GetRandomWardrobeItemFromPath(TEXT("Hair"), BaseHairPath);
+	// 	return RandomHairItem;
+	// 	UE_LOG(LogTemp, Log, TEXT("Generated random hair item: %s"), *RandomHairItem);
+	// }
+	// Random hair from predefined list instead of MetaHuman plugin
+	// TArray<FString> AllHairPaths = {
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBuns.WI_Hair_S_UpdoBuns"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_UpdoBraids.WI_Hair_S_UpdoBraids"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Updo.WI_Hair_S_Updo"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SweptUp.WI_Hair_S_SweptUp"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SlickBack.WI_Hair_S_SlickBack"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_SideSweptFringe.WI_Hair_S_SideSweptFringe"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_RecedeMessy.WI_Hair_S_RecedeMessy"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_PulledBack.WI_Hair_S_PulledBack"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Pixie.WI_Hair_S_Pixie"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Messy.WI_Hair_S_Messy"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_LowPonytail.WI_Hair_S_LowPonytail"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_HairLoss.WI_Hair_S_HairLoss"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CurlyFade.WI_Hair_S_CurlyFade"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Cornrows.WI_Hair_S_Cornrows"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_CoilBuzzCut.WI_Hair_S_CoilBuzzCut"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Coil.WI_Hair_S_Coil"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Clean.WI_Hair_S_Clean"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_Casual.WI_Hair_S_Casual"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BuzzCut.WI_Hair_S_BuzzCut"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BrushCut.WI_Hair_S_BrushCut"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BobLayered.WI_Hair_S_BobLayered"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_BaldingStubble.WI_Hair_S_BaldingStubble"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_AfroFade.WI_Hair_S_AfroFade"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_S_360Waves.WI_Hair_S_360Waves"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_TwistedBraids.WI_Hair_M_TwistedBraids"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_SideSweptFringe.WI_Hair_M_SideSweptFringe"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Mohawk.WI_Hair_M_Mohawk"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_Layered.WI_Hair_M_Layered"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_FauxMohawk.WI_Hair_M_FauxMohawk"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobStraight.WI_Hair_M_BobStraight"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobSlick.WI_Hair_M_BobSlick"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobMessy.WI_Hair_M_BobMessy"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobCurly.WI_Hair_M_BobCurly"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_M_BobBangs.WI_Hair_M_BobBangs"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_StraightBangs.WI_Hair_L_StraightBangs"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_Straight.WI_Hair_L_Straight"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_MessyClumps.WI_Hair_L_MessyClumps"),
+	// 	TEXT("/MetaHumanCharacter/Optional/Grooms/Bindings/Hair/WI_Hair_L_AfroCurly.WI_Hair_L_AfroCurly")
+	// };
+
+	TArray<FString> FinalHairPaths;
+	if (bIsFemale)
+	{
+		FinalHairPaths = FemaleHairPaths;
+		FinalHairPaths.Append(UnisexHairPaths);
+	}
+	else
+	{
+		FinalHairPaths = MaleHairPaths;
+		FinalHairPaths.Append(UnisexHairPaths);
+	}
+
+	int32 Index = Stream.RandRange(0, FinalHairPaths.Num() - 1);
+	return FinalHairPaths[Index];
+}
+
+static void DrawClothingPaths(FRandomStream& Stream, TArray<FString>& OutClothingPaths)
+{
+	auto RandomChoice = [&Stream](const TArray<FString>& Array) -> FString
+	{
+		if (Array.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[BatchPlanner] RandomChoice: Array is empty"));
+			return FString("");
+		}
+		int32 index = Stream.RandRange(0, Array.Num() - 1);
+		return Array[index];
+	};
+
+	// {
+	// 	// random clothing from UE Metahuman Plugin Content
+	// 	FString BaseClothingPath = TEXT("/MetaHumanCharacter/Optional/Clothing");
+	// 	// Get random clothing item
+	// 	FString RandomClothingItem = UMetaHumanParametricGenerator::GetRandomWardrobeItemFromPath(TEXT("Outfits"), BaseClothingPath);
+	// 	OutClothingPaths.Empty();
+	// 	OutClothingPaths.Add(RandomClothingItem);
+	// 	UE_LOG(LogTemp, Log, TEXT("Generated random clothing item: %s"), *RandomClothingItem);
+	// }
+	int32 Roll;
+	OutClothingPaths.Empty();
+	
+
+
+
+
+	
+	Roll = Stream.RandRange(1, 100);
+	if (Roll <= 20) // use UpperAndLowerCloth
+	{
+	 	OutClothingPaths.Add(RandomChoice(UpperAndLowerCloth));
+	}
+	else
+	{
+		OutClothingPaths.Add(RandomChoice(UpperCloth));
+		OutClothingPaths.Add(RandomChoice(LowerCloth));
+	}
+
+	
+	// Shoes
+	Roll = Stream.RandRange(1, 100);
+	if (Roll <= 15) // Do not wear shoes
+	{
+		// pass
+	}
+	else
+	{
+		OutClothingPaths.Add(RandomChoice(Shoes));
+	}
+	
+
+	// OtherItems
+	Roll = Stream.RandRange(1, 100);
+	if (Roll <= 10) // wear other items
+	{
+		OutClothingPaths.Add(RandomChoice(OtherItems));
+	}
+}
+
+} // namespace BatchPlannerDraws
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+FMetaHumanBatchManifest UMetaHumanBatchPlanner::PlanBatch(int32 BatchSeed, int32 Count, int32 FirstIndex)
+{
+	FMetaHumanBatchManifest Manifest;
+	Manifest.BatchSeed = BatchSeed;
+
+	if (Count <= 0)
+	{
+		return Manifest;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Entries are two integers each - expansion is deferred to the worker that consumes them
+	Manifest.Entries.SetNumUninitialized(Count);
+	for (int32 Offset = 0; Offset < Count; ++Offset)
+	{
+		FMetaHumanBatchManifestEntry& Entry = Manifest.Entries[Offset];
+		Entry.Index = FirstIndex + Offset;
+		Entry.Seed = GetEntrySeed(BatchSeed, Entry.Index);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BatchPlanner] Planned %d entries (seed %d, first index %d) in %.2f ms"),
+		Count, BatchSeed, FirstIndex, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return Manifest;
+}
+
+int32 UMetaHumanBatchPlanner::GetEntrySeed(int32 BatchSeed, int32 Index)
+{
+	return static_cast<int32>(HashCombine(GetTypeHash(BatchSeed), GetTypeHash(Index)));
+}
+
+// ============================================================================
+// Expansion
+// ============================================================================
+
+void UMetaHumanBatchPlanner::ExpandEntry(
+	const FMetaHumanBatchManifestEntry& Entry,
+	EMetaHumanQualityLevel QualityLevel,
+	FMetaHumanBodyParametricConfig& OutBodyConfig,
+	FMetaHumanAppearanceConfig& OutAppearanceConfig,
+	FString& OutCharacterName)
+{
+	// Every draw comes from the entry's own stream, so the result only depends on Entry.Seed
+	FRandomStream Stream(Entry.Seed);
+
+	int32 RandomBodyTypeIndex = Stream.RandRange(0, 17);
+	OutBodyConfig.BodyType = static_cast<EMetaHumanBodyType>(RandomBodyTypeIndex);
+	// OutBodyConfig.BodyType = EMetaHumanBodyType::BlendableBody;
+
+	OutBodyConfig.GlobalDeltaScale = 1.0f;
+	OutBodyConfig.bUseParametricBody = true;
+	OutBodyConfig.BodyMeasurements.Empty();
+
+	float MasculineFeminine = Stream.FRandRange(-1.5f, 1.5f);
+	bool bIsFemale = true;
+	if (MasculineFeminine < 0.0f) 
+	{
+		bIsFemale = false;
+	}
+	OutBodyConfig.BodyMeasurements.Add(TEXT("Masculine/Feminine"), MasculineFeminine);
+	OutBodyConfig.BodyMeasurements.Add(TEXT("Muscularity"), Stream.FRandRange(-1.5f, 1.5f));
+	OutBodyConfig.BodyMeasurements.Add(TEXT("Fat"), Stream.FRandRange(-0.5f, 1.0f));
+	OutBodyConfig.BodyMeasurements.Add(TEXT("Height"), Stream.FRandRange(150.0f, 185.0f));
+
+	OutBodyConfig.QualityLevel = QualityLevel;
+
+	int32 EthnicityRoll = Stream.RandRange(1, 100);
+	FString EthnicityCode;
+
+	if (EthnicityRoll <= 90)
+	{
+		OutAppearanceConfig.SkinSettings.Skin.U = Stream.FRandRange(0.25f, 0.4f);
+		OutAppearanceConfig.SkinSettings.Skin.V = Stream.FRandRange(0.0f, 0.3f);
+
+		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.PrimaryColorU = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.PrimaryColorV = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.SecondaryColorU = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeLeft.Iris.SecondaryColorV = 0.0f;
+
+		OutAppearanceConfig.EyesSettings.EyeRight.Iris.PrimaryColorU = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeRight.Iris.PrimaryColorV = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeRight.Iris.SecondaryColorU = 0.0f;
+		OutAppearanceConfig.EyesSettings.EyeRight.Iris.SecondaryColorV = 0.0f;
+
+		OutAppearanceConfig.WardrobeConfig.HairParameters->Melanin = 1.0f;
+		EthnicityCode = TEXT("AS"); // Asian
+	}
+	else if (EthnicityRoll <= 95)
+	{
+		OutAppearanceConfig.SkinSettings.Skin.U = Stream.FRandRange(0.0f, 0.2f);
+		OutAppearanceConfig.SkinSettings.Skin.V = Stream.FRandRange(0.4f, 1.0f);
+		EthnicityCode = TEXT("AF"); // African
+	}
+	else
+	{
+		OutAppearanceConfig.SkinSettings.Skin.U = Stream.FRandRange(0.6f, 1.0f);
+		OutAppearanceConfig.SkinSettings.Skin.V = Stream.FRandRange(0.0f, 1.0f);
+		EthnicityCode = TEXT("EU"); // European
+	}
+
+	BatchPlannerDraws::DrawWardrobeColors(Stream, OutAppearanceConfig.WardrobeConfig);
+
+	OutAppearanceConfig.SkinSettings.Skin.Roughness = Stream.FRandRange(0.0f, 1.0f);
+	OutAppearanceConfig.SkinSettings.Skin.bShowTopUnderwear = true;
+	OutAppearanceConfig.SkinSettings.Skin.BodyTextureIndex = Stream.RandRange(0, 8);
+	// see I:\UE_5.6\Engine\Plugins\MetaHuman\MetaHumanCharacter\Content\Optional\TextureSynthesis\TS-1.3-D_UE_res-1024_nchr-153\texture_attributes.json
+	//a['attributes']['Face Stubble']['values']          
+	// [0, 3, 1, 1, 2, 0, 3, 0, 3, 1, 0, 1, 0, 2, 0, 3, 0, 0, 0, 1, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 
+    //  0, 1, 0, 1, 1, 0, 0, 2, 0, 0, 2, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 1, 2, 0, 0, 1, 0, 3, 0, 2, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 0, 2, 0, 0, 3, 0, 0, 0, 2, 0, 3, 2, 0, 0, 0, 1, 0, 3, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 1, 0, 2, 2, 2, 0, 3, 0, 0, 1, 0, 2, 1, 0, 1, 1, 0, 2, 0, 1, 0, 3]
+	// 0-1 for female, 0-3 for male
+	const TArray<int32> FaceTextureStubbleMapp = {0, 3, 1, 1, 2, 0, 3, 0, 3, 1, 0, 1, 0, 2, 0, 3, 0, 0, 0, 1, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 2, 0, 0, 2, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 1, 2, 0, 0, 1, 0, 3, 0, 2, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 2, 0, 2, 2, 0, 0, 2, 0, 0, 3, 0, 0, 0, 2, 0, 3, 2, 0, 0, 0, 1, 0, 3, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 1, 0, 2, 2, 2, 0, 3, 0, 0, 1, 0, 2, 1, 0, 1, 1, 0, 2, 0, 1, 0, 3};
+	TArray<int32> FemaleFaceTextureIndexSet;
+	TArray<int32> MaleFaceTextureIndexSet;
+	for (int32 Index = 0; Index < FaceTextureStubbleMapp.Num(); ++Index)
+	{
+		int32 StubbleValue = FaceTextureStubbleMapp[Index];
+		// if (StubbleValue >= 0 && StubbleValue <= 1)
+		if (StubbleValue >= 0 && StubbleValue <= 0)
+		{
+			FemaleFaceTextureIndexSet.Add(Index);
+		}
+		if (StubbleValue >= 0 && StubbleValue <= 3)
+		{
+			MaleFaceTextureIndexSet.Add(Index);
+		}
+	}
+	int32 RandomIndex;
+	if (bIsFemale)
+	{
+		RandomIndex = FemaleFaceTextureIndexSet[Stream.RandRange(0, FemaleFaceTextureIndexSet.Num() - 1)];
+	}
+	else
+	{
+		RandomIndex = MaleFaceTextureIndexSet[Stream.RandRange(0, MaleFaceTextureIndexSet.Num() - 1)];
+	}
+	OutAppearanceConfig.SkinSettings.Skin.FaceTextureIndex = RandomIndex;
+	// OutAppearanceConfig.SkinSettings.Skin.FaceTextureIndex = Stream.RandRange(0, 152);
+
+	if (EthnicityCode == TEXT("AS")) // Asian
+	{
+		OutAppearanceConfig.SkinSettings.Freckles.Density = Stream.FRandRange(0.0f, 0.5f);
+		OutAppearanceConfig.SkinSettings.Freckles.Strength = Stream.FRandRange(0.0f, 0.5f);
+	}
+	else
+	{
+		OutAppearanceConfig.SkinSettings.Freckles.Density = Stream.FRandRange(0.0f, 1.0f);
+		OutAppearanceConfig.SkinSettings.Freckles.Strength = Stream.FRandRange(0.0f, 1.0f);
+	}
+	OutAppearanceConfig.SkinSettings.Freckles.Saturation = Stream.FRandRange(0.0f, 1.0f);
+	OutAppearanceConfig.SkinSettings.Freckles.ToneShift = Stream.FRandRange(0.0f, 1.0f);
+
+	int32 FrecklesRoll = Stream.RandRange(1, 100);
+	if (FrecklesRoll <= 70)
+	{
+		OutAppearanceConfig.SkinSettings.Freckles.Mask = EMetaHumanCharacterFrecklesMask::None;
+	}
+	else
+	{
+		OutAppearanceConfig.SkinSettings.Freckles.Mask = static_cast<EMetaHumanCharacterFrecklesMask>(Stream.RandRange(1, 3));
+	}
+
+	OutAppearanceConfig.HeadModelSettings.Eyelashes.bEnableGrooms = false;
+
+	OutAppearanceConfig.WardrobeConfig.HairPath = BatchPlannerDraws::DrawHairPath(Stream, bIsFemale);
+
+	BatchPlannerDraws::DrawClothingPaths(Stream, OutAppearanceConfig.WardrobeConfig.ClothingPaths);
+
+	// Generate character name based on ethnicity, gender and the entry itself,
+	// so re-expanding an entry always yields the same asset name
+	FString GenderCode = bIsFemale ? TEXT("F") : TEXT("M");
+
+	OutCharacterName = FString::Printf(TEXT("%s-%s-BatchGen-%06d_%08X"),
+		*EthnicityCode,
+		*GenderCode,
+		Entry.Index,
+		static_cast<uint32>(Entry.Seed));
+}
+
+void UMetaHumanBatchPlanner::ExpandWardrobeVariant(
+	const FMetaHumanBatchManifestEntry& Entry,
+	int32 VariantIndex,
+	const FMetaHumanBodyParametricConfig& BaseBodyConfig,
+	const FMetaHumanWardrobeConfig& BaseWardrobe,
+	FMetaHumanWardrobeConfig& OutWardrobe)
+{
+	OutWardrobe = BaseWardrobe;
+	if (VariantIndex <= 0)
+	{
+		return;
+	}
+
+	// Never share the hair parameters object with the base, the draws below would change both
+	OutWardrobe.HairParameters = NewObject<UMetaHumanDefaultGroomPipelineMaterialParameters>();
+	if (BaseWardrobe.HairParameters)
+	{
+		// Melanin follows the ethnicity of the face, so it is kept
+		OutWardrobe.HairParameters->Melanin = BaseWardrobe.HairParameters->Melanin;
+	}
+
+	FRandomStream Stream(HashCombine(GetTypeHash(Entry.Seed), GetTypeHash(VariantIndex)));
+	const bool bIsFemale = BaseBodyConfig.BodyMeasurements.FindRef(TEXT("Masculine/Feminine")) >= 0.0f;
+
+	BatchPlannerDraws::DrawWardrobeColors(Stream, OutWardrobe);
+	OutWardrobe.HairPath = BatchPlannerDraws::DrawHairPath(Stream, bIsFemale);
+	BatchPlannerDraws::DrawClothingPaths(Stream, OutWardrobe.ClothingPaths);
+}
+
+FString UMetaHumanBatchPlanner::GetVariantName(const FString& BaseName, int32 VariantIndex)
+{
+	return VariantIndex <= 0 ? BaseName : FString::Printf(TEXT("%s_V%02d"), *BaseName, VariantIndex);
+}
+
+void UMetaHumanBatchPlanner::GetWardrobeCatalog(TArray<FString>& OutItemPaths)
+{
+	using namespace BatchPlannerDraws;
+
+	OutItemPaths.Reset();
+	for (const TArray<FString>* Candidates : { &MaleHairPaths, &FemaleHairPaths, &UnisexHairPaths,
+		&UpperAndLowerCloth, &UpperCloth, &LowerCloth, &Shoes, &FullSuit, &OtherItems })
+	{
+		for (const FString& ItemPath : *Candidates)
+		{
+			OutItemPaths.AddUnique(ItemPath);
+		}
+	}
+}
+
+// ============================================================================
+// Manifest Files
+// ============================================================================
+
+bool UMetaHumanBatchPlanner::WriteManifestToFile(
+	int32 BatchSeed,
+	int32 Count,
+	const FString& FilePath,
+	bool bExpandConfigs,
+	EMetaHumanQualityLevel QualityLevel,
+	int32 FirstIndex)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FString Directory = FPaths::GetPath(FilePath);
+	if (!PlatformFile.DirectoryExists(*Directory))
+	{
+		PlatformFile.CreateDirectoryTree(*Directory);
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchPlanner] Failed to open manifest for writing: %s"), *FilePath);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Offset = 0; Offset < Count; ++Offset)
+	{
+		FMetaHumanBatchManifestEntry Entry;
+		Entry.Index = FirstIndex + Offset;
+		Entry.Seed = GetEntrySeed(BatchSeed, Entry.Index);
+
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		JsonObject->SetNumberField(TEXT("BatchSeed"), BatchSeed);
+		JsonObject->SetNumberField(TEXT("Index"), Entry.Index);
+		JsonObject->SetNumberField(TEXT("Seed"), Entry.Seed);
+
+		if (bExpandConfigs)
+		{
+			FMetaHumanBodyParametricConfig BodyConfig;
+			FMetaHumanAppearanceConfig AppearanceConfig;
+			FString CharacterName;
+			ExpandEntry(Entry, QualityLevel, BodyConfig, AppearanceConfig, CharacterName);
+
+			JsonObject->SetStringField(TEXT("CharacterName"), CharacterName);
+			JsonObject->SetObjectField(TEXT("BodyConfig"), FJsonObjectConverter::UStructToJsonObject(BodyConfig));
+			JsonObject->SetObjectField(TEXT("SkinSettings"), FJsonObjectConverter::UStructToJsonObject(AppearanceConfig.SkinSettings));
+			JsonObject->SetObjectField(TEXT("EyesSettings"), FJsonObjectConverter::UStructToJsonObject(AppearanceConfig.EyesSettings));
+			JsonObject->SetObjectField(TEXT("HeadModelSettings"), FJsonObjectConverter::UStructToJsonObject(AppearanceConfig.HeadModelSettings));
+			JsonObject->SetObjectField(TEXT("WardrobeColors"), FJsonObjectConverter::UStructToJsonObject(AppearanceConfig.WardrobeConfig.ColorConfig));
+			JsonObject->SetStringField(TEXT("HairPath"), AppearanceConfig.WardrobeConfig.HairPath);
+
+			TArray<TSharedPtr<FJsonValue>> ClothingArray;
+			for (const FString& ClothingPath : AppearanceConfig.WardrobeConfig.ClothingPaths)
+			{
+				ClothingArray.Add(MakeShared<FJsonValueString>(ClothingPath));
+			}
+			JsonObject->SetArrayField(TEXT("ClothingPaths"), ClothingArray);
+
+			if (AppearanceConfig.WardrobeConfig.HairParameters)
+			{
+				JsonObject->SetObjectField(TEXT("HairParameters"), FJsonObjectConverter::UStructToJsonObject(
+					AppearanceConfig.WardrobeConfig.HairParameters->GetClass(), AppearanceConfig.WardrobeConfig.HairParameters.Get()));
+			}
+		}
+
+		// One compact JSON object per line
+		FString Line;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+		if (!FJsonSerializer::Serialize(JsonObject, Writer))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[BatchPlanner] Failed to serialize manifest entry %d"), Entry.Index);
+			return false;
+		}
+		Line += TEXT("\n");
+
+		FTCHARToUTF8 Utf8Line(*Line);
+		FileWriter->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+	}
+
+	const bool bSuccess = FileWriter->Close();
+
+	UE_LOG(LogTemp, Log, TEXT("[BatchPlanner] Wrote %d manifest entries%s to %s in %.2f ms"),
+		Count, bExpandConfigs ? TEXT(" (expanded)") : TEXT(""), *FilePath, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return bSuccess;
+}
+
+bool UMetaHumanBatchPlanner::LoadManifestFromFile(const FString& FilePath, FMetaHumanBatchManifest& OutManifest)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BatchPlanner] Failed to read manifest: %s"), *FilePath);
+		return false;
+	}
+
+	OutManifest = FMetaHumanBatchManifest();
+	OutManifest.Entries.Reserve(Lines.Num());
+
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		const FString& Line = Lines[LineIndex];
+		if (Line.TrimStartAndEnd().IsEmpty())
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[BatchPlanner] Invalid manifest line %d in %s"), LineIndex + 1, *FilePath);
+			return false;
+		}
+
+		FMetaHumanBatchManifestEntry& Entry = OutManifest.Entries.AddDefaulted_GetRef();
+		Entry.Index = JsonObject->GetIntegerField(TEXT("Index"));
+		Entry.Seed = static_cast<int32>(JsonObject->GetNumberField(TEXT("Seed")));
+
+		if (OutManifest.Entries.Num() == 1)
+		{
+			OutManifest.BatchSeed = static_cast<int32>(JsonObject->GetNumberField(TEXT("BatchSeed")));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[BatchPlanner] Loaded %d manifest entries from %s"), OutManifest.Entries.Num(), *FilePath);
+	return true;
+}
+
+FString UMetaHumanBatchPlanner::GetDefaultManifestDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("Manifests"));
+}
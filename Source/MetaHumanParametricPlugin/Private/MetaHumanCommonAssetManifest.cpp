@@ -0,0 +1,218 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Common Asset Manifest - Implementation
+
+#include "MetaHumanCommonAssetManifest.h"
+#include "MetaHumanAtomicFile.h"
+#include "Serialization/ArchiveUObject.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "Misc/SecureHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace MetaHumanCommonAssetManifest
+{
+	/** First line of the manifest file - bump when the format or the hash changes, old files are then ignored */
+	static const FString FileHeader = TEXT("MHCommonAssets 2");
+
+	/**
+	 * Feeds everything an object serializes into a SHA1
+	 * References to other objects and names are hashed by path and text, so the digest does not depend
+	 * on where objects live in memory or on the name table of this process.
+	 */
+	class FArchiveObjectSha1 : public FArchiveUObject
+	{
+	public:
+		explicit FArchiveObjectSha1(FSHA1& InSha)
+			: Sha(InSha)
+		{
+			SetIsSaving(true);
+			SetIsPersistent(true);
+		}
+
+		virtual void Serialize(void* Data, int64 Num) override
+		{
+			Sha.Update(static_cast<const uint8*>(Data), Num);
+		}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			FString NameString = Name.ToString();
+			return *this << NameString;
+		}
+
+		virtual FArchive& operator<<(UObject*& Object) override
+		{
+			FString PathName = Object ? Object->GetPathName() : FString();
+			return *this << PathName;
+		}
+
+		virtual FString GetArchiveName() const override
+		{
+			return TEXT("FArchiveObjectSha1");
+		}
+
+	private:
+		FSHA1& Sha;
+	};
+
+	struct FEntry
+	{
+		FString ContentHash;
+		int64 FileSize = 0;
+		int64 TimestampTicks = 0;
+	};
+
+	/** Package name -> last recorded write, loaded from the manifest file on first use */
+	static TMap<FString, FEntry> Entries;
+	static bool bLoaded = false;
+	static bool bDirty = false;
+
+	static void LoadIfNeeded()
+	{
+		if (bLoaded)
+		{
+			return;
+		}
+		bLoaded = true;
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FMetaHumanCommonAssetManifest::GetManifestFilePath()) || Lines.IsEmpty() || Lines[0] != FileHeader)
+		{
+			return;
+		}
+
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+		{
+			TArray<FString> Fields;
+			if (Lines[LineIndex].ParseIntoArray(Fields, TEXT("\t")) != 4)
+			{
+				continue;
+			}
+
+			FEntry& Entry = Entries.Add(Fields[0]);
+			Entry.ContentHash = Fields[1];
+			LexFromString(Entry.FileSize, *Fields[2]);
+			LexFromString(Entry.TimestampTicks, *Fields[3]);
+		}
+	}
+}
+
+FString FMetaHumanCommonAssetManifest::ComputeContentHash(UPackage* Package)
+{
+	if (!Package)
+	{
+		return FString();
+	}
+
+	// Subobjects included - each object's own serialization only refers to them by path
+	TArray<UObject*> Objects;
+	GetObjectsWithOuter(Package, Objects, /*bIncludeNestedObjects*/ true);
+	Objects.RemoveAll([](const UObject* Object)
+	{
+		// Not saved with the package either
+		return Object->HasAnyFlags(RF_Transient);
+	});
+	if (Objects.IsEmpty())
+	{
+		return FString();
+	}
+	Objects.Sort([](const UObject& A, const UObject& B)
+	{
+		return A.GetPathName() < B.GetPathName();
+	});
+
+	// The full serialized bytes go into the digest, no per-object checksum that could collide
+	FSHA1 Sha;
+	FArchiveObjectSha1 ShaArchive(Sha);
+	for (UObject* Object : Objects)
+	{
+		FString Header = Object->GetClass()->GetPathName() + TEXT("|") + Object->GetPathName();
+		ShaArchive << Header;
+		Object->Serialize(ShaArchive);
+	}
+	Sha.Final();
+
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+bool FMetaHumanCommonAssetManifest::IsUpToDate(const UPackage* Package, const FString& PackageFileName, const FString& ContentHash, int64& OutFileSize)
+{
+	using namespace MetaHumanCommonAssetManifest;
+
+	OutFileSize = 0;
+	if (!Package || ContentHash.IsEmpty())
+	{
+		return false;
+	}
+
+	LoadIfNeeded();
+	const FEntry* Entry = Entries.Find(Package->GetName());
+	if (!Entry || Entry->ContentHash != ContentHash)
+	{
+		return false;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const int64 FileSize = FileManager.FileSize(*PackageFileName);
+	if (FileSize != Entry->FileSize || FileManager.GetTimeStamp(*PackageFileName).GetTicks() != Entry->TimestampTicks)
+	{
+		return false;
+	}
+
+	OutFileSize = FileSize;
+	return true;
+}
+
+void FMetaHumanCommonAssetManifest::Record(const UPackage* Package, const FString& PackageFileName, const FString& ContentHash)
+{
+	using namespace MetaHumanCommonAssetManifest;
+
+	if (!Package || ContentHash.IsEmpty())
+	{
+		return;
+	}
+
+	LoadIfNeeded();
+	IFileManager& FileManager = IFileManager::Get();
+	FEntry& Entry = Entries.FindOrAdd(Package->GetName());
+	Entry.ContentHash = ContentHash;
+	Entry.FileSize = FileManager.FileSize(*PackageFileName);
+	Entry.TimestampTicks = FileManager.GetTimeStamp(*PackageFileName).GetTicks();
+	bDirty = true;
+}
+
+void FMetaHumanCommonAssetManifest::SaveIfDirty()
+{
+	using namespace MetaHumanCommonAssetManifest;
+
+	if (!bDirty)
+	{
+		return;
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(FileHeader);
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		Lines.Add(FString::Printf(TEXT("%s\t%s\t%lld\t%lld"),
+			*Pair.Key, *Pair.Value.ContentHash, Pair.Value.FileSize, Pair.Value.TimestampTicks));
+	}
+
+	// Entries lost to another process writing at the same time only cost a redundant save of that package
+	const FString FilePath = GetManifestFilePath();
+	if (!FMetaHumanAtomicFile::SaveStringArray(Lines, FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CommonAssets] Failed to save %s"), *FilePath);
+		return;
+	}
+	bDirty = false;
+}
+
+FString FMetaHumanCommonAssetManifest::GetManifestFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("CommonAssets.txt"));
+}
@@ -1,7 +1,9 @@
 #include "MetaHumanConfigSerializer.h"
+#include "MetaHumanAtomicFile.h"
 #include "Misc/FileHelper.h"
 #include "Misc/DateTime.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/FileManager.h"
 
 UMetaHumanConfigSerializer::UMetaHumanConfigSerializer()
 {
@@ -146,11 +148,13 @@ bool UMetaHumanConfigSerializer::SaveGenerationSession(
     const FString& OutputPath,
     const FMetaHumanBodyParametricConfig& BodyConfig,
     const FMetaHumanAppearanceConfig& AppearanceConfig,
-    const FString& Status)
+    const FString& Status,
+    EMetaHumanTextureResolution TextureResolution)
 {
     FMetaHumanGenerationSession Session = CreateSessionFromCurrentGeneration(
         CharacterName, OutputPath, BodyConfig, AppearanceConfig);
     Session.GenerationStatus = Status;
+    Session.TextureResolution = TextureResolution;
 
     FString SessionFilePath = GetSessionFilePath(CharacterName);
 
@@ -179,6 +183,25 @@ bool UMetaHumanConfigSerializer::UpdateSessionStatus(const FString& CharacterNam
     return SaveFullSessionToJson(Session, SessionFilePath);
 }
 
+bool UMetaHumanConfigSerializer::UpdateSessionOutputs(
+    const FString& CharacterName,
+    const FString& NewStatus,
+    const TArray<FMetaHumanGenerationSessionOutput>& Outputs)
+{
+    FString SessionFilePath = GetSessionFilePath(CharacterName);
+
+    FMetaHumanGenerationSession Session;
+    if (!LoadFullSessionFromJson(Session, SessionFilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to load session for character: %s"), *CharacterName);
+        return false;
+    }
+
+    Session.GenerationStatus = NewStatus;
+    Session.Outputs = Outputs;
+    return SaveFullSessionToJson(Session, SessionFilePath);
+}
+
 FMetaHumanGenerationSession UMetaHumanConfigSerializer::CreateSessionFromCurrentGeneration(
     const FString& CharacterName,
     const FString& OutputPath,
@@ -286,6 +309,17 @@ TSharedPtr<FJsonObject> UMetaHumanConfigSerializer::SessionToJson(const FMetaHum
     JsonObject->SetStringField(TEXT("CharacterName"), Session.CharacterName);
     JsonObject->SetStringField(TEXT("OutputPath"), Session.OutputPath);
     JsonObject->SetStringField(TEXT("GenerationStatus"), Session.GenerationStatus);
+    JsonObject->SetStringField(TEXT("TextureResolution"), *UEnum::GetValueAsString(Session.TextureResolution));
+
+    TArray<TSharedPtr<FJsonValue>> OutputsArray;
+    for (const FMetaHumanGenerationSessionOutput& Output : Session.Outputs)
+    {
+        TSharedPtr<FJsonObject> OutputObj = MakeShareable(new FJsonObject);
+        OutputObj->SetStringField(TEXT("QualityLevel"), *UEnum::GetValueAsString(Output.QualityLevel));
+        OutputObj->SetStringField(TEXT("OutputPath"), Output.OutputPath);
+        OutputsArray.Add(MakeShareable(new FJsonValueObject(OutputObj)));
+    }
+    JsonObject->SetArrayField(TEXT("Outputs"), OutputsArray);
 
     TSharedPtr<FJsonObject> BodyConfigObj = BodyConfigToJson(Session.BodyConfig);
     JsonObject->SetObjectField(TEXT("BodyConfig"), BodyConfigObj);
@@ -433,6 +467,38 @@ bool UMetaHumanConfigSerializer::JsonToSession(const TSharedPtr<FJsonObject>& Js
     JsonObject->TryGetStringField(TEXT("OutputPath"), OutSession.OutputPath);
     JsonObject->TryGetStringField(TEXT("GenerationStatus"), OutSession.GenerationStatus);
 
+    FString TextureResolutionString;
+    if (JsonObject->TryGetStringField(TEXT("TextureResolution"), TextureResolutionString))
+    {
+        const int64 TextureResolutionValue = StaticEnum<EMetaHumanTextureResolution>()->GetValueByNameString(TextureResolutionString);
+        if (TextureResolutionValue != INDEX_NONE)
+        {
+            OutSession.TextureResolution = static_cast<EMetaHumanTextureResolution>(TextureResolutionValue);
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* OutputsArray;
+    if (JsonObject->TryGetArrayField(TEXT("Outputs"), OutputsArray))
+    {
+        for (const TSharedPtr<FJsonValue>& OutputValue : *OutputsArray)
+        {
+            const TSharedPtr<FJsonObject>* OutputObj;
+            FString QualityLevelString;
+            if (!OutputValue->TryGetObject(OutputObj) || !(*OutputObj)->TryGetStringField(TEXT("QualityLevel"), QualityLevelString))
+            {
+                continue;
+            }
+
+            const int64 QualityLevelValue = StaticEnum<EMetaHumanQualityLevel>()->GetValueByNameString(QualityLevelString);
+            if (QualityLevelValue != INDEX_NONE)
+            {
+                FMetaHumanGenerationSessionOutput& Output = OutSession.Outputs.AddDefaulted_GetRef();
+                Output.QualityLevel = static_cast<EMetaHumanQualityLevel>(QualityLevelValue);
+                (*OutputObj)->TryGetStringField(TEXT("OutputPath"), Output.OutputPath);
+            }
+        }
+    }
+
     FString TimestampString;
     if (JsonObject->TryGetStringField(TEXT("Timestamp"), TimestampString))
     {
@@ -474,7 +540,7 @@ bool UMetaHumanConfigSerializer::WriteJsonToFile(const TSharedPtr<FJsonObject>&
         return false;
     }
 
-    if (!FFileHelper::SaveStringToFile(OutputString, *FilePath))
+    if (!FMetaHumanAtomicFile::SaveString(OutputString, FilePath))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to save JSON to file: %s"), *FilePath);
         return false;
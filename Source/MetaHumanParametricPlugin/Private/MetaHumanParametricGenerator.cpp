@@ -14,13 +14,18 @@
 #include "MetaHumanPipelineSlotSelection.h"
 #include "MetaHumanAssetIOUtility.h"
 #include "MetaHumanAssemblyPipelineManager.h"
+#include "MetaHumanCommonAssetManifest.h"
 #include "MetaHumanWardrobeItem.h"
 #include "MetaHumanConfigSerializer.h"
+#include "MetaHumanRigCache.h"
+#include "MetaHumanAppearanceTransaction.h"
+#include "MetaHumanWardrobeCatalog.h"
 #include "MetaHumanCollectionEditorPipeline.h"
 #include "MetaHumanPinnedSlotSelection.h"
 
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/SavePackage.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectHash.h"
 #include "Misc/PackageName.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Engine/SimpleConstructionScript.h"
@@ -34,7 +39,6 @@
 #include <UObject/UnrealType.h>
 #include "Item/MetaHumanDefaultGroomPipeline.h"
 #include "Interfaces/ITargetPlatformManagerModule.h"
-#include "FileHelpers.h"
 
 
 UMetaHumanCharacterEditorSubsystem* UMetaHumanParametricGenerator::getEditorSubsystem()
@@ -66,112 +70,349 @@ bool UMetaHumanParametricGenerator::PrepareAndRigCharacter(
 	const FMetaHumanAppearanceConfig& AppearanceConfig,
 	UMetaHumanCharacter*& OutCharacter)
 {
-	UE_LOG(LogTemp, Log, TEXT("=== Step 1: Prepare and Rig Character ==="));
-	UE_LOG(LogTemp, Log, TEXT("Character Name: %s"), *CharacterName);
-	UE_LOG(LogTemp, Log, TEXT("Output Path: %s"), *OutputPath);
+	EMetaHumanGenerationFailure Failure;
+	return PrepareAndRigCharacter(CharacterName, OutputPath, BodyConfig, AppearanceConfig, OutCharacter, Failure);
+}
 
-	// Step 0: Save configuration to JSON first (before any operations that might fail)
-	UE_LOG(LogTemp, Log, TEXT("[Step 0/5] Saving configuration to JSON..."));
-	if (!UMetaHumanConfigSerializer::SaveGenerationSession(CharacterName, OutputPath, BodyConfig, AppearanceConfig, TEXT("Preparing")))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Failed to save configuration to JSON, but generation will continue"));
-	}
-	else
+bool UMetaHumanParametricGenerator::PrepareAndRigCharacter(
+	const FString& CharacterName,
+	const FString& OutputPath,
+	const FMetaHumanBodyParametricConfig& BodyConfig,
+	const FMetaHumanAppearanceConfig& AppearanceConfig,
+	UMetaHumanCharacter*& OutCharacter,
+	EMetaHumanGenerationFailure& OutFailure)
+{
+	OutCharacter = nullptr;
+
+	FMetaHumanPrepareContext Context;
+	Context.CharacterName = CharacterName;
+	Context.OutputPath = OutputPath;
+	Context.BodyConfig = BodyConfig;
+	Context.AppearanceConfig = AppearanceConfig;
+	Context.bBlockingAuth = true;
+
+	// Run every step back to back - the batch subsystem calls RunPrepareStep itself to spread them over frames
+	while (!Context.IsDone())
 	{
-		UE_LOG(LogTemp, Log, TEXT("[Step 0/5] ✓ Configuration saved to JSON successfully"));
+		if (!RunPrepareStep(Context))
+		{
+			OutFailure = Context.Failure;
+			return false;
+		}
 	}
 
-	// Step 1: Check authentication
-	UE_LOG(LogTemp, Log, TEXT("[Step 1/5] Verifying MetaHuman cloud services authentication..."));
-	if (!EnsureCloudServicesLogin())
+	OutFailure = EMetaHumanGenerationFailure::None;
+	OutCharacter = Context.Character.Get();
+	return OutCharacter != nullptr;
+}
+
+bool UMetaHumanParametricGenerator::RunPrepareStep(FMetaHumanPrepareContext& Context)
+{
+	const FString& CharacterName = Context.CharacterName;
+	const FMetaHumanAppearanceConfig& AppearanceConfig = Context.AppearanceConfig;
+	Context.bWaiting = false;
+
+	auto Fail = [&Context, &CharacterName](EMetaHumanGenerationFailure Failure, const TCHAR* Status)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to authenticate with MetaHuman cloud services!"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_Authentication"));
+		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, Status);
+		Context.Failure = Failure;
 		return false;
-	}
-	UE_LOG(LogTemp, Log, TEXT("[Step 1/5] ✓ Authentication verified"));
+	};
 
-	// Step 2: Create base character
-	UE_LOG(LogTemp, Log, TEXT("[Step 2/5] Creating base MetaHuman Character asset..."));
-	UMetaHumanCharacter* Character = CreateBaseCharacter(
-		OutputPath,
-		CharacterName,
-		EMetaHumanCharacterTemplateType::MetaHuman
-	);
+	// Every step but the first two needs the character created in CreateCharacter
+	UMetaHumanCharacter* Character = Context.Character.Get();
+	if (!Character && Context.Step > EMetaHumanPrepareStep::CreateCharacter && Context.Step != EMetaHumanPrepareStep::Done)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Character was destroyed during preparation!"));
+		return Fail(EMetaHumanGenerationFailure::Create, TEXT("Failed_CreateCharacter"));
+	}
 
-	if (!Character)
+	switch (Context.Step)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to create base character!"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_CreateCharacter"));
-		return false;
+	case EMetaHumanPrepareStep::SaveSession:
+	{
+		UE_LOG(LogTemp, Log, TEXT("=== Step 1: Prepare and Rig Character ==="));
+		UE_LOG(LogTemp, Log, TEXT("Character Name: %s"), *CharacterName);
+		UE_LOG(LogTemp, Log, TEXT("Output Path: %s"), *Context.OutputPath);
+
+		// Step 0: Save configuration to JSON first (before any operations that might fail)
+		UE_LOG(LogTemp, Log, TEXT("[Step 0/5] Saving configuration to JSON..."));
+		if (!UMetaHumanConfigSerializer::SaveGenerationSession(CharacterName, Context.OutputPath, Context.BodyConfig, AppearanceConfig, TEXT("Preparing"), Context.TextureResolution))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to save configuration to JSON, but generation will continue"));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Step 0/5] ✓ Configuration saved to JSON successfully"));
+		}
+		Context.Step = EMetaHumanPrepareStep::Authenticate;
+		return true;
 	}
-	UE_LOG(LogTemp, Log, TEXT("[Step 2/5] ✓ Base character created"));
 
-	// Step 3: Configure body and appearance
-	UE_LOG(LogTemp, Log, TEXT("[Step 3/5] Configuring body parameters and appearance..."));
-	if (!ConfigureBodyParameters(Character, BodyConfig))
+	case EMetaHumanPrepareStep::Authenticate:
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to configure body parameters!"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_ConfigureBody"));
-		return false;
+		// Step 1: Check authentication
+		if (Context.bBlockingAuth)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Step 1/5] Verifying MetaHuman cloud services authentication..."));
+			if (!EnsureCloudServicesLogin())
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to authenticate with MetaHuman cloud services!"));
+				return Fail(EMetaHumanGenerationFailure::Auth, TEXT("Failed_Authentication"));
+			}
+		}
+		else
+		{
+			// Non-blocking: start the check once, then report "still waiting" until the callback fired
+			if (!Context.AuthCheck.IsValid())
+			{
+				UE_LOG(LogTemp, Log, TEXT("[Step 1/5] Verifying MetaHuman cloud services authentication (async)..."));
+				TestCloudAuthentication();
+
+				TSharedPtr<FMetaHumanPrepareContext::FAuthCheck, ESPMode::ThreadSafe> AuthCheck = MakeShared<FMetaHumanPrepareContext::FAuthCheck, ESPMode::ThreadSafe>();
+				AuthCheck->StartTime = FPlatformTime::Seconds();
+				Context.AuthCheck = AuthCheck;
+				CheckCloudServicesLoginAsync([AuthCheck](bool bLoggedIn)
+				{
+					AuthCheck->bLoggedIn = bLoggedIn;
+					AuthCheck->bComplete = true;
+				});
+				Context.bWaiting = true;
+				return true;
+			}
+
+			if (!Context.AuthCheck->bComplete)
+			{
+				if (FPlatformTime::Seconds() - Context.AuthCheck->StartTime < 5.0)
+				{
+					Context.bWaiting = true;
+					return true;
+				}
+				UE_LOG(LogTemp, Error, TEXT("Timeout while checking cloud services login status"));
+				Context.AuthCheck.Reset();
+				return Fail(EMetaHumanGenerationFailure::Auth, TEXT("Failed_Authentication"));
+			}
+
+			const bool bLoggedIn = Context.AuthCheck->bLoggedIn;
+			Context.AuthCheck.Reset();
+			if (!bLoggedIn)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to authenticate with MetaHuman cloud services!"));
+				return Fail(EMetaHumanGenerationFailure::Auth, TEXT("Failed_Authentication"));
+			}
+		}
+		UE_LOG(LogTemp, Log, TEXT("[Step 1/5] ✓ Authentication verified"));
+		Context.Step = EMetaHumanPrepareStep::CreateCharacter;
+		return true;
 	}
 
-	if (!ConfigureAppearance(Character, AppearanceConfig))
+	case EMetaHumanPrepareStep::CreateCharacter:
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to configure appearance!"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_ConfigureAppearance"));
-		return false;
+		// Step 2: Create base character
+		UE_LOG(LogTemp, Log, TEXT("[Step 2/5] Creating base MetaHuman Character asset..."));
+		const double StepStartTime = FPlatformTime::Seconds();
+		if (Context.bUseCharacterPrototype)
+		{
+			double PrototypeInitSeconds = 0.0;
+			Character = CreateCharacterFromPrototype(
+				Context.OutputPath,
+				CharacterName,
+				EMetaHumanCharacterTemplateType::MetaHuman,
+				PrototypeInitSeconds
+			);
+			Context.PrototypeInitSeconds = PrototypeInitSeconds;
+		}
+		else
+		{
+			Character = CreateBaseCharacter(
+				Context.OutputPath,
+				CharacterName,
+				EMetaHumanCharacterTemplateType::MetaHuman
+			);
+		}
+		Context.CreateCharacterSeconds = FPlatformTime::Seconds() - StepStartTime;
+
+		if (!Character)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create base character!"));
+			return Fail(EMetaHumanGenerationFailure::Create, TEXT("Failed_CreateCharacter"));
+		}
+		UE_LOG(LogTemp, Log, TEXT("[Step 2/5] ✓ Base character created"));
+		Context.Character = Character;
+		Context.Step = EMetaHumanPrepareStep::ConfigureBody;
+		return true;
 	}
-	UE_LOG(LogTemp, Log, TEXT("[Step 3/5] ✓ Configuration complete"));
 
-	UE_LOG(LogTemp, Log, TEXT("[Step 3.5/5] Adding selected hair and clothing..."));
+	case EMetaHumanPrepareStep::ConfigureBody:
+	{
+		// Step 3: Configure body and appearance
+		UE_LOG(LogTemp, Log, TEXT("[Step 3/5] Configuring body parameters and appearance..."));
+		if (!ConfigureBodyParameters(Character, Context.BodyConfig))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to configure body parameters!"));
+			return Fail(EMetaHumanGenerationFailure::Configure, TEXT("Failed_ConfigureBody"));
+		}
+		Context.Step = EMetaHumanPrepareStep::ConfigureAppearance;
+		return true;
+	}
 
-	// Apply selected hair from wardrobe config
-	if (AppearanceConfig.WardrobeConfig.HairPath.IsEmpty())
+	case EMetaHumanPrepareStep::ConfigureAppearance:
 	{
-		UE_LOG(LogTemp, Error, TEXT("  Hair path is empty in wardrobe config"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_AddHair"));
-		return false;
+		if (!ConfigureAppearance(Character, AppearanceConfig))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to configure appearance!"));
+			return Fail(EMetaHumanGenerationFailure::Configure, TEXT("Failed_ConfigureAppearance"));
+		}
+		UE_LOG(LogTemp, Log, TEXT("[Step 3/5] ✓ Configuration complete"));
+		Context.Step = EMetaHumanPrepareStep::AddHair;
+		return true;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("  Adding hair: %s"), *AppearanceConfig.WardrobeConfig.HairPath);
-	if (!AddHair(Character, AppearanceConfig.WardrobeConfig.HairPath))
+	case EMetaHumanPrepareStep::AddHair:
 	{
-		UE_LOG(LogTemp, Error, TEXT("  Failed to add hair"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_AddHair"));
-		return false;
+		UE_LOG(LogTemp, Log, TEXT("[Step 3.5/5] Adding selected hair and clothing..."));
+
+		// Apply selected hair from wardrobe config
+		if (AppearanceConfig.WardrobeConfig.HairPath.IsEmpty())
+		{
+			UE_LOG(LogTemp, Error, TEXT("  Hair path is empty in wardrobe config"));
+			return Fail(EMetaHumanGenerationFailure::Wardrobe, TEXT("Failed_AddHair"));
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("  Adding hair: %s"), *AppearanceConfig.WardrobeConfig.HairPath);
+		if (!AddHair(Character, AppearanceConfig.WardrobeConfig.HairPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("  Failed to add hair"));
+			return Fail(EMetaHumanGenerationFailure::Wardrobe, TEXT("Failed_AddHair"));
+		}
+
+		if (!ApplyHairParameters(Character, AppearanceConfig.WardrobeConfig.HairParameters))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Failed to apply hair parameters"));
+		}
+		Context.ClothingIndex = 0;
+		Context.Step = EMetaHumanPrepareStep::AddClothing;
+		return true;
 	}
 
-	if (!ApplyHairParameters(Character, AppearanceConfig.WardrobeConfig.HairParameters))
+	case EMetaHumanPrepareStep::AddClothing:
 	{
-		UE_LOG(LogTemp, Warning, TEXT("  Failed to apply hair parameters"));
+		// Apply selected clothing from wardrobe config, one item per step
+		const int32 Index = Context.ClothingIndex;
+		if (AppearanceConfig.WardrobeConfig.ClothingPaths.IsValidIndex(Index))
+		{
+			const FString& ClothingPath = AppearanceConfig.WardrobeConfig.ClothingPaths[Index];
+			UE_LOG(LogTemp, Log, TEXT("  Adding clothing [%d/%d]: %s"), Index + 1, AppearanceConfig.WardrobeConfig.ClothingPaths.Num(), *ClothingPath);
+			if (!AddClothing(Character, ClothingPath, Index))
+			{
+				UE_LOG(LogTemp, Error, TEXT("  Failed to add clothing [%d]"), Index);
+				return Fail(EMetaHumanGenerationFailure::Wardrobe, TEXT("Failed_AddClothing"));
+			}
+			UE_LOG(LogTemp, Log, TEXT("  ✓ Clothing [%d/%d] added successfully"), Index + 1, AppearanceConfig.WardrobeConfig.ClothingPaths.Num());
+			Context.ClothingIndex++;
+		}
+
+		if (!AppearanceConfig.WardrobeConfig.ClothingPaths.IsValidIndex(Context.ClothingIndex))
+		{
+			Context.Step = EMetaHumanPrepareStep::WardrobeColors;
+		}
+		return true;
 	}
 
-	// Apply selected clothing from wardrobe config
-	for (int32 Index = 0; Index < AppearanceConfig.WardrobeConfig.ClothingPaths.Num(); ++Index)
+	case EMetaHumanPrepareStep::WardrobeColors:
 	{
-		const FString& ClothingPath = AppearanceConfig.WardrobeConfig.ClothingPaths[Index];
-		UE_LOG(LogTemp, Log, TEXT("  Adding clothing [%d/%d]: %s"), Index + 1, AppearanceConfig.WardrobeConfig.ClothingPaths.Num(), *ClothingPath);
-		if (!AddClothing(Character, ClothingPath, Index))
+		// Apply wardrobe color parameters
+		if (ApplyWardrobeColorParameters(Character, AppearanceConfig.WardrobeConfig.ColorConfig))
 		{
-			UE_LOG(LogTemp, Error, TEXT("  Failed to add clothing [%d]"), Index);
-			UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_AddClothing"));
-			return false;
+			UE_LOG(LogTemp, Log, TEXT("  ✓ Wardrobe color parameters applied"));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Failed to apply wardrobe color parameters"));
 		}
-		UE_LOG(LogTemp, Log, TEXT("  ✓ Clothing [%d/%d] added successfully"), Index + 1, AppearanceConfig.WardrobeConfig.ClothingPaths.Num());
+
+		UE_LOG(LogTemp, Log, TEXT("[Step 3.5/5] ✓ Wardrobe items added"));
+		Context.Step = EMetaHumanPrepareStep::PreviewBuild;
+		return true;
 	}
 
-	// Apply wardrobe color parameters
-	if (ApplyWardrobeColorParameters(Character, AppearanceConfig.WardrobeConfig.ColorConfig))
+	case EMetaHumanPrepareStep::PreviewBuild:
 	{
-		UE_LOG(LogTemp, Log, TEXT("  ✓ Wardrobe color parameters applied"));
+		// Clothing is only initialized for Chaos cloth by the preview build, so it is never skipped for it
+		if (Context.bBuildPreview || !AppearanceConfig.WardrobeConfig.ClothingPaths.IsEmpty())
+		{
+			const double StepStartTime = FPlatformTime::Seconds();
+			BuildCollectionPreview(Character);
+			Context.PreviewBuildSeconds = FPlatformTime::Seconds() - StepStartTime;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("Skipping collection preview build (no clothing, assembly builds the collection)"));
+		}
+		Context.Step = EMetaHumanPrepareStep::StartAutoRig;
+		return true;
 	}
-	else
+
+	case EMetaHumanPrepareStep::StartAutoRig:
 	{
-		UE_LOG(LogTemp, Warning, TEXT("  Failed to apply wardrobe color parameters"));
+		// Step 5: Start AutoRig (ASYNC - returns immediately!)
+		UE_LOG(LogTemp, Log, TEXT("[Step 5/5] Starting AutoRig (async cloud operation)..."));
+
+		UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+		if (!EditorSubsystem)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to get editor subsystem"));
+			return Fail(EMetaHumanGenerationFailure::Rig, TEXT("Failed_GetEditorSubsystem"));
+		}
+
+		// Check if already rigged
+		EMetaHumanCharacterRigState RigState = EditorSubsystem->GetRiggingState(Character);
+		if (RigState == EMetaHumanCharacterRigState::Rigged)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Character already rigged, ready for assembly"));
+			UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Rigged"));
+			Context.Step = EMetaHumanPrepareStep::Done;
+			return true;
+		}
+
+		// The same face was rigged before - reuse its DNA instead of a cloud round trip
+		// Keep the key - the rig is stored under it once AutoRig is done
+		Context.RigCacheKey = Context.bUseRigCache ? FMetaHumanRigCache::ComputeKey(Character) : FString();
+		if (Context.bUseRigCache && FMetaHumanRigCache::TryApply(Character, Context.RigCacheKey))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Step 5/5] ✓ Face rig restored from the rig cache, AutoRig skipped"));
+			UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Rigged"));
+			Context.bRigCacheHit = true;
+			Context.Step = EMetaHumanPrepareStep::Done;
+			return true;
+		}
+
+		StartAutoRig(Character);
+
+		UE_LOG(LogTemp, Log, TEXT("[Step 5/5] ✓ AutoRig started (running in background)"));
+		UE_LOG(LogTemp, Log, TEXT("=== Step 1 Complete - AutoRig is now running in the background ==="));
+		UE_LOG(LogTemp, Log, TEXT("Use GetRiggingStatusString() to check progress"));
+		UE_LOG(LogTemp, Log, TEXT("When rigged, call AssembleCharacter() to finish"));
+
+		// Update configuration status to AutoRigging
+		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("AutoRigging"));
+		Context.Step = EMetaHumanPrepareStep::Done;
+		return true;
+	}
+
+	case EMetaHumanPrepareStep::Done:
+		return true;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[Step 3.5/5] ✓ Wardrobe items added"));
+	return true;
+}
+
+bool UMetaHumanParametricGenerator::BuildCollectionPreview(UMetaHumanCharacter* Character)
+{
+	if (!Character)
+	{
+		return false;
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("Building collection preview (required for Chaos clothing initialization)..."));
 	TNotNull<UMetaHumanCollection*> Collection = Character->GetMutableInternalCollection();
@@ -192,31 +433,71 @@ bool UMetaHumanParametricGenerator::PrepareAndRigCharacter(
 			Collection->GetDefaultInstance()->ToPinnedSlotSelections(EMetaHumanUnusedSlotBehavior::PinnedToEmpty));
 
 		UE_LOG(LogTemp, Log, TEXT("✓ Collection preview build triggered (Chaos clothing initialized)"));
+		return true;
 	}
-	else
+
+	UE_LOG(LogTemp, Warning, TEXT("Failed to get BuildInputStruct for preview build"));
+	return false;
+}
+
+bool UMetaHumanParametricGenerator::ApplyWardrobe(UMetaHumanCharacter* Character, const FMetaHumanWardrobeConfig& WardrobeConfig, bool bBuildPreview)
+{
+	if (!Character)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Failed to get BuildInputStruct for preview build"));
+		UE_LOG(LogTemp, Error, TEXT("Invalid character for applying wardrobe"));
+		return false;
 	}
 
-	// Step 5: Start AutoRig (ASYNC - returns immediately!)
-	UE_LOG(LogTemp, Log, TEXT("[Step 5/5] Starting AutoRig (async cloud operation)..."));
+	// Face, body and rig are left alone - only the wardrobe slots and their material parameters change
+	RemoveWardrobeItem(Character, TEXT("Hair"));
+	RemoveWardrobeItem(Character, TEXT("Outfits"));
 
-	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
-	if (!EditorSubsystem)
+	if (!WardrobeConfig.HairPath.IsEmpty() && !AddHair(Character, WardrobeConfig.HairPath))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to get editor subsystem"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Failed_GetEditorSubsystem"));
+		UE_LOG(LogTemp, Error, TEXT("  Failed to add hair: %s"), *WardrobeConfig.HairPath);
 		return false;
 	}
 
-	// Check if already rigged
-	EMetaHumanCharacterRigState RigState = EditorSubsystem->GetRiggingState(Character);
-	if (RigState == EMetaHumanCharacterRigState::Rigged)
+	for (int32 Index = 0; Index < WardrobeConfig.ClothingPaths.Num(); ++Index)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Character already rigged, ready for assembly"));
-		UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("Rigged"));
-		OutCharacter = Character;
-		return true;
+		if (!AddClothing(Character, WardrobeConfig.ClothingPaths[Index], Index))
+		{
+			UE_LOG(LogTemp, Error, TEXT("  Failed to add clothing [%d]: %s"), Index, *WardrobeConfig.ClothingPaths[Index]);
+			return false;
+		}
+	}
+
+	if (!ApplyHairParameters(Character, WardrobeConfig.HairParameters))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("  Failed to apply hair parameters"));
+	}
+	if (!ApplyWardrobeColorParameters(Character, WardrobeConfig.ColorConfig))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("  Failed to apply wardrobe color parameters"));
+	}
+
+	if (bBuildPreview || !WardrobeConfig.ClothingPaths.IsEmpty())
+	{
+		BuildCollectionPreview(Character);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("✓ Wardrobe applied: hair %s, %d clothing item(s)"), *WardrobeConfig.HairPath, WardrobeConfig.ClothingPaths.Num());
+	return true;
+}
+
+bool UMetaHumanParametricGenerator::StartAutoRig(UMetaHumanCharacter* Character)
+{
+	if (!Character)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Invalid character for AutoRig"));
+		return false;
+	}
+
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+	if (!EditorSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to get editor subsystem"));
+		return false;
 	}
 
 	// Remove old rig if exists
@@ -230,16 +511,6 @@ bool UMetaHumanParametricGenerator::PrepareAndRigCharacter(
 
 	// Start AutoRig (asynchronous - returns immediately!)
 	EditorSubsystem->AutoRigFace(Character, UE::MetaHuman::ERigType::JointsAndBlendshapes);
-
-	UE_LOG(LogTemp, Log, TEXT("[Step 5/5] ✓ AutoRig started (running in background)"));
-	UE_LOG(LogTemp, Log, TEXT("=== Step 1 Complete - AutoRig is now running in the background ==="));
-	UE_LOG(LogTemp, Log, TEXT("Use GetRiggingStatusString() to check progress"));
-	UE_LOG(LogTemp, Log, TEXT("When rigged, call AssembleCharacter() to finish"));
-
-	// Update configuration status to AutoRigging
-	UMetaHumanConfigSerializer::UpdateSessionStatus(CharacterName, TEXT("AutoRigging"));
-
-	OutCharacter = Character;
 	return true;
 }
 
@@ -247,11 +518,268 @@ bool UMetaHumanParametricGenerator::PrepareAndRigCharacter(
 // Two-Step Generation Workflow - Step 2: Assemble Character
 // ============================================================================
 
+namespace MetaHumanAssemblyPackages
+{
+	/** Add every package in memory that lies under one of the content folders */
+	static void CollectPackagesInFolders(const TArray<FString>& Folders, TArray<UPackage*>& OutPackages)
+	{
+		TArray<FString> Prefixes;
+		for (const FString& Folder : Folders)
+		{
+			if (!Folder.IsEmpty())
+			{
+				Prefixes.Add(Folder.EndsWith(TEXT("/")) ? Folder : Folder + TEXT("/"));
+			}
+		}
+
+		ForEachObjectOfClass(UPackage::StaticClass(), [&OutPackages, &Prefixes](UObject* Object)
+		{
+			const FString PackageName = Object->GetName();
+			for (const FString& Prefix : Prefixes)
+			{
+				if (PackageName.StartsWith(Prefix))
+				{
+					OutPackages.AddUnique(CastChecked<UPackage>(Object));
+					break;
+				}
+			}
+		}, /*bIncludeDerivedClasses*/ false);
+	}
+
+	static FString GetPackageFileName(const UPackage* Package)
+	{
+		return FPackageName::LongPackageNameToFilename(
+			Package->GetName(),
+			Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+	}
+
+	/**
+	 * Save the dirty packages of one assembly: the character, its build folder and the common folder
+	 * Unrelated dirty packages of the session (maps, earlier jobs) are not touched.
+	 * The build folder's packages belong to this assembly alone and are serialized side by side with
+	 * UPackage::SaveConcurrent; the character and common packages go one at a time, since the common
+	 * ones are checked against the manifest first.
+	 * @param bAsync - Hand the build folder's packages to the async file writer. The character and common
+	 *                 packages are saved again by later assemblies, so they are written before returning
+	 *                 to keep two writes of one file from overlapping.
+	 * @param bSkipUnchangedCommon - Leave common packages whose content is already on disk (see FMetaHumanCommonAssetManifest)
+	 */
+	static bool SaveAssembledPackages(
+		UMetaHumanCharacter* Character,
+		const FMetaHumanAssemblyBuildParameters& BuildParams,
+		bool bAsync,
+		bool bSkipUnchangedCommon,
+		FMetaHumanAssemblyStats& OutStats)
+	{
+		OutStats.SavedPackages = 0;
+		OutStats.SavedBytes = 0;
+		OutStats.SkippedPackages = 0;
+		OutStats.SkippedBytes = 0;
+
+		TArray<UPackage*> CommonPackages;
+		CollectPackagesInFolders({ BuildParams.CommonFolderPath }, CommonPackages);
+
+		TArray<UPackage*> AssemblyPackages;
+		CollectPackagesInFolders({ BuildParams.AbsoluteBuildPath / BuildParams.NameOverride }, AssemblyPackages);
+
+		bool bAllSaved = true;
+		auto RecordResult = [&](const FSavePackageResultStruct& Result, const FString& PackageFileName)
+		{
+			// The result carries the serialized size, async writes may not have reached the disk yet
+			if (!Result.IsSuccessful())
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to save package to %s"), *PackageFileName);
+				bAllSaved = false;
+				return false;
+			}
+
+			OutStats.SavedPackages++;
+			OutStats.SavedBytes += FMath::Max<int64>(0, Result.TotalFileSize);
+			return true;
+		};
+
+		auto SavePackages = [&](const TArray<UPackage*>& Packages, bool bCommon)
+		{
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.SaveFlags = SAVE_NoError;
+
+			for (UPackage* Package : Packages)
+			{
+				if (!Package->IsDirty() || Package == GetTransientPackage())
+				{
+					continue;
+				}
+
+				const FString PackageFileName = GetPackageFileName(Package);
+
+				FString ContentHash;
+				if (bCommon)
+				{
+					// The build regenerates the shared assets for every character, usually with the same content
+					ContentHash = FMetaHumanCommonAssetManifest::ComputeContentHash(Package);
+					int64 FileSize = 0;
+					if (bSkipUnchangedCommon && FMetaHumanCommonAssetManifest::IsUpToDate(Package, PackageFileName, ContentHash, FileSize))
+					{
+						Package->SetDirtyFlag(false);
+						OutStats.SkippedPackages++;
+						OutStats.SkippedBytes += FileSize;
+						continue;
+					}
+				}
+
+				if (RecordResult(UPackage::Save(Package, nullptr, *PackageFileName, SaveArgs), PackageFileName) && bCommon)
+				{
+					FMetaHumanCommonAssetManifest::Record(Package, PackageFileName, ContentHash);
+				}
+			}
+		};
+
+		// Meshes, textures, physics assets and the blueprint of the assembly do not depend on each other's saves
+		TArray<FPackageSaveInfo> ConcurrentSaves;
+		for (UPackage* Package : AssemblyPackages)
+		{
+			if (Package->IsDirty() && Package != GetTransientPackage())
+			{
+				FPackageSaveInfo& SaveInfo = ConcurrentSaves.AddDefaulted_GetRef();
+				SaveInfo.Package = Package;
+				SaveInfo.Filename = GetPackageFileName(Package);
+			}
+		}
+		if (ConcurrentSaves.Num() > 0)
+		{
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.SaveFlags = SAVE_NoError | SAVE_Concurrent | (bAsync ? SAVE_Async : SAVE_None);
+
+			TArray<FSavePackageResultStruct> Results;
+			UPackage::SaveConcurrent(ConcurrentSaves, SaveArgs, Results);
+			for (int32 SaveIndex = 0; SaveIndex < ConcurrentSaves.Num(); ++SaveIndex)
+			{
+				RecordResult(Results.IsValidIndex(SaveIndex) ? Results[SaveIndex] : FSavePackageResultStruct(ESavePackageResult::Error),
+					ConcurrentSaves[SaveIndex].Filename);
+			}
+		}
+
+		SavePackages({ Character->GetPackage() }, false);
+		SavePackages(CommonPackages, true);
+		FMetaHumanCommonAssetManifest::SaveIfDirty();
+		return bAllSaved;
+	}
+}
+
+bool UMetaHumanParametricGenerator::HasPendingAssemblySaves()
+{
+	return UPackage::HasAsyncFileWrites();
+}
+
+void UMetaHumanParametricGenerator::WaitForAssemblySaves()
+{
+	UPackage::WaitForAsyncFileWrites();
+}
+
 bool UMetaHumanParametricGenerator::AssembleCharacter(
 	UMetaHumanCharacter* Character,
 	const FString& OutputPath,
 	EMetaHumanQualityLevel QualityLevel)
 {
+	FMetaHumanAssemblyStats Stats;
+	return AssembleCharacter(Character, OutputPath, QualityLevel, Stats);
+}
+
+bool UMetaHumanParametricGenerator::AssembleCharacter(
+	UMetaHumanCharacter* Character,
+	const FString& OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	FMetaHumanAssemblyStats& OutStats)
+{
+	return AssembleCharacter(Character, OutputPath, QualityLevel, FMetaHumanAssemblyOptions(), OutStats);
+}
+
+bool UMetaHumanParametricGenerator::AssembleCharacter(
+	UMetaHumanCharacter* Character,
+	const FString& OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	const FMetaHumanAssemblyOptions& Options,
+	FMetaHumanAssemblyStats& OutStats)
+{
+	if (!AssembleCharacterAtQuality(Character, OutputPath, QualityLevel, Options, OutStats))
+	{
+		return false;
+	}
+	UpdateAssembledSessionStatus(Character, OutputPath, { QualityLevel }, Options);
+	return true;
+}
+
+bool UMetaHumanParametricGenerator::AssembleCharacter(
+	UMetaHumanCharacter* Character,
+	const FString& OutputPath,
+	const TArray<EMetaHumanQualityLevel>& QualityLevels,
+	const FMetaHumanAssemblyOptions& Options,
+	TArray<FMetaHumanAssemblyStats>& OutStats)
+{
+	OutStats.Reset();
+
+	if (!Character || QualityLevels.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Invalid character or no quality level for assembly"));
+		return false;
+	}
+
+	// One texture request for every level - the largest resolution any of them uses
+	FMetaHumanAssemblyOptions LevelOptions = Options;
+	LevelOptions.bFetchTextures = false;
+	LevelOptions.TextureResolution = ResolveTextureResolution(Options.TextureResolution, QualityLevels);
+	double TextureSeconds = 0.0;
+	if (Options.bFetchTextures && LevelOptions.TextureResolution != EMetaHumanTextureResolution::None)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Downloading texture source data for %d quality level(s)..."), QualityLevels.Num());
+		const double StartTime = FPlatformTime::Seconds();
+		if (!DownloadTextureSourceData(Character, LevelOptions.TextureResolution))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Warning: Failed to download texture source data"));
+		}
+		TextureSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	// The rig and textures are shared, each further level only costs its build and save
+	for (const EMetaHumanQualityLevel QualityLevel : QualityLevels)
+	{
+		FMetaHumanAssemblyStats& LevelStats = OutStats.AddDefaulted_GetRef();
+		const FString LevelOutputPath = GetQualityOutputPath(OutputPath, QualityLevel, QualityLevels);
+		if (!AssembleCharacterAtQuality(Character, LevelOutputPath, QualityLevel, LevelOptions, LevelStats))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Assembly at quality level %s failed"), *UEnum::GetValueAsString(QualityLevel));
+			return false;
+		}
+	}
+	OutStats[0].TextureSeconds += TextureSeconds;
+
+	UpdateAssembledSessionStatus(Character, OutputPath, QualityLevels, Options);
+	return true;
+}
+
+FString UMetaHumanParametricGenerator::GetQualityOutputPath(
+	const FString& OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	const TArray<EMetaHumanQualityLevel>& QualityLevels)
+{
+	if (QualityLevels.Num() <= 1)
+	{
+		return OutputPath;
+	}
+	return OutputPath / StaticEnum<EMetaHumanQualityLevel>()->GetNameStringByValue(static_cast<int64>(QualityLevel));
+}
+
+bool UMetaHumanParametricGenerator::AssembleCharacterAtQuality(
+	UMetaHumanCharacter* Character,
+	const FString& OutputPath,
+	EMetaHumanQualityLevel QualityLevel,
+	const FMetaHumanAssemblyOptions& Options,
+	FMetaHumanAssemblyStats& OutStats)
+{
+	OutStats = FMetaHumanAssemblyStats();
+
 	if (!Character)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Invalid character for assembly"));
@@ -260,6 +788,10 @@ bool UMetaHumanParametricGenerator::AssembleCharacter(
 
 	UE_LOG(LogTemp, Log, TEXT("=== Step 2: Assemble Character ==="));
 	UE_LOG(LogTemp, Log, TEXT("Character: %s"), *Character->GetName());
+	if (!Options.NameOverride.IsEmpty())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Assembled As: %s"), *Options.NameOverride);
+	}
 	UE_LOG(LogTemp, Log, TEXT("Output Path: %s"), *OutputPath);
 
 	// Check if rigged
@@ -289,25 +821,48 @@ bool UMetaHumanParametricGenerator::AssembleCharacter(
 	UE_LOG(LogTemp, Log, TEXT("✓ Character is rigged, proceeding with assembly..."));
 
 	// Step 4: Download texture source data
-	UE_LOG(LogTemp, Log, TEXT("Downloading texture source data..."));
-	if (!DownloadTextureSourceData(Character))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Warning: Failed to download texture source data"));
-	}
-	else
-	{
-		UE_LOG(LogTemp, Log, TEXT(" ✓ Texture source data downloaded"));
+	double StepStartTime = FPlatformTime::Seconds();
+	const EMetaHumanTextureResolution TextureResolution = ResolveTextureResolution(Options.TextureResolution, QualityLevel);
+	if (Options.bFetchTextures && TextureResolution != EMetaHumanTextureResolution::None)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Downloading texture source data..."));
+		const bool bTexturesRequested = DownloadTextureSourceData(Character, TextureResolution);
+		OutStats.TextureSeconds = FPlatformTime::Seconds() - StepStartTime;
+		if (!bTexturesRequested)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Warning: Failed to download texture source data"));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT(" ✓ Texture source data downloaded"));
+		}
 	}
 
 	// Assemble using native pipeline
+	StepStartTime = FPlatformTime::Seconds();
+	const FMetaHumanPipelineCacheStats PipelineCacheBefore = UMetaHumanAssemblyPipelineManager::GetPipelineCacheStats();
 	FMetaHumanAssemblyBuildParameters BuildParams =
 		UMetaHumanAssemblyPipelineManager::CreateDefaultBuildParameters(
 			Character,
 			QualityLevel,
 			OutputPath
 		);
+	if (!Options.NameOverride.IsEmpty())
+	{
+		BuildParams.NameOverride = Options.NameOverride;
+	}
+	if (!Options.CommonFolderSuffix.IsEmpty())
+	{
+		BuildParams.CommonFolderPath += Options.CommonFolderSuffix;
+	}
+	const FMetaHumanPipelineCacheStats PipelineCacheAfter = UMetaHumanAssemblyPipelineManager::GetPipelineCacheStats();
+	OutStats.PipelineSeconds = FPlatformTime::Seconds() - StepStartTime;
+	OutStats.bPipelineCacheHit = PipelineCacheAfter.Hits > PipelineCacheBefore.Hits;
 
-	if (!UMetaHumanAssemblyPipelineManager::BuildMetaHumanCharacter(Character, BuildParams))
+	StepStartTime = FPlatformTime::Seconds();
+	const bool bBuilt = UMetaHumanAssemblyPipelineManager::BuildMetaHumanCharacter(Character, BuildParams);
+	OutStats.BuildSeconds = FPlatformTime::Seconds() - StepStartTime;
+	if (!bBuilt)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to assemble character with native pipeline!"));
 		return false;
@@ -318,33 +873,53 @@ bool UMetaHumanParametricGenerator::AssembleCharacter(
 	UE_LOG(LogTemp, Log, TEXT("  Output Path: %s"), *OutputPath);
 	UE_LOG(LogTemp, Log, TEXT("=== Step 2 Complete - Character is ready! ==="));
 
-	UE_LOG(LogTemp, Log, TEXT("Saving all generated assets (SKM, Blueprint, etc.)..."));
-	bool bPromptUserToSave = false;
-	bool bSaveMapPackages = true;
-	bool bSaveContentPackages = true;
-	bool bFastSave = false;
-	bool bNotifyNoPackagesSaved = false;
-	bool bCanBeDeclined = false;
+	UE_LOG(LogTemp, Log, TEXT("Saving generated assets (SKM, Blueprint, etc.)..."));
+	StepStartTime = FPlatformTime::Seconds();
+	const bool bSaved = MetaHumanAssemblyPackages::SaveAssembledPackages(
+		Character, BuildParams, Options.bAsyncSave, Options.bSkipUnchangedCommonAssets, OutStats);
+	OutStats.SaveSeconds = FPlatformTime::Seconds() - StepStartTime;
+	OutStats.bSaveFailed = !bSaved;
 
-	if (FEditorFileUtils::SaveDirtyPackages(
-		bPromptUserToSave,
-		bSaveMapPackages,
-		bSaveContentPackages,
-		bFastSave,
-		bNotifyNoPackagesSaved,
-		bCanBeDeclined))
+	if (!bSaved)
 	{
-		UE_LOG(LogTemp, Log, TEXT("✓ All generated assets saved successfully"));
+		// Missing packages leave a broken MetaHuman on disk - report it so the caller can retry
+		UE_LOG(LogTemp, Error, TEXT("Failed to save some of the assembled packages"));
+		return false;
 	}
-	else
+
+	UE_LOG(LogTemp, Log, TEXT("✓ Generated assets saved: %d package(s), %.1f MB%s"),
+		OutStats.SavedPackages, OutStats.SavedBytes / (1024.0 * 1024.0), Options.bAsyncSave ? TEXT(" (writing in the background)") : TEXT(""));
+	if (OutStats.SkippedPackages > 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Failed to save some packages, but character was assembled"));
+		UE_LOG(LogTemp, Log, TEXT("  Common folder: %d unchanged package(s), %.1f MB not saved again"),
+			OutStats.SkippedPackages, OutStats.SkippedBytes / (1024.0 * 1024.0));
 	}
 
-	if (Character->GetName() != TEXT("None"))
-	{
-		UE_LOG(LogTemp, Log, TEXT("Updating session status to completed..."));
-		if (!UMetaHumanConfigSerializer::UpdateSessionStatus(Character->GetName(), TEXT("Completed")))
+	return true;
+}
+
+void UMetaHumanParametricGenerator::UpdateAssembledSessionStatus(
+	UMetaHumanCharacter* Character,
+	const FString& OutputPath,
+	const TArray<EMetaHumanQualityLevel>& QualityLevels,
+	const FMetaHumanAssemblyOptions& Options)
+{
+	const FString SessionName = Options.NameOverride.IsEmpty() ? Character->GetName() : Options.NameOverride;
+	if (SessionName != TEXT("None"))
+	{
+		// Async writes are still in flight - the caller marks the session Completed after WaitForAssemblySaves
+		const TCHAR* SessionStatus = Options.bAsyncSave ? TEXT("Saving") : TEXT("Completed");
+		UE_LOG(LogTemp, Log, TEXT("Updating session status to %s..."), SessionStatus);
+		// The session's OutputPath is the batch root - record where each level actually went
+		TArray<FMetaHumanGenerationSessionOutput> Outputs;
+		for (const EMetaHumanQualityLevel QualityLevel : QualityLevels)
+		{
+			FMetaHumanGenerationSessionOutput& Output = Outputs.AddDefaulted_GetRef();
+			Output.QualityLevel = QualityLevel;
+			Output.OutputPath = GetQualityOutputPath(OutputPath, QualityLevel, QualityLevels);
+		}
+
+		if (!UMetaHumanConfigSerializer::UpdateSessionOutputs(SessionName, SessionStatus, Outputs))
 		{
 			UE_LOG(LogTemp, Warning, TEXT("Failed to update session status, but character was assembled successfully"));
 		}
@@ -353,8 +928,6 @@ bool UMetaHumanParametricGenerator::AssembleCharacter(
 			UE_LOG(LogTemp, Log, TEXT("Session status updated successfully"));
 		}
 	}
-
-	return true;
 }
 
 // ============================================================================
@@ -451,6 +1024,150 @@ UMetaHumanCharacter* UMetaHumanParametricGenerator::CreateBaseCharacter(
 	return Character;
 }
 
+// ============================================================================
+// Character Prototypes
+// ============================================================================
+
+namespace MetaHumanCharacterPrototypes
+{
+	/** One initialized, never edited character per template type */
+	static TMap<EMetaHumanCharacterTemplateType, TStrongObjectPtr<UMetaHumanCharacter>> Prototypes;
+}
+
+UMetaHumanCharacter* UMetaHumanParametricGenerator::CreateCharacterFromPrototype(
+	const FString& PackagePath,
+	const FString& CharacterName,
+	EMetaHumanCharacterTemplateType TemplateType,
+	double& OutPrototypeInitSeconds)
+{
+	OutPrototypeInitSeconds = 0.0;
+
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+	if (!EditorSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to get MetaHumanCharacterEditorSubsystem"));
+		return nullptr;
+	}
+
+	// 1. Prototype of the template type - the expensive initialization happens once
+	TStrongObjectPtr<UMetaHumanCharacter>& Prototype = MetaHumanCharacterPrototypes::Prototypes.FindOrAdd(TemplateType);
+	if (!Prototype.IsValid())
+	{
+		const double InitStartTime = FPlatformTime::Seconds();
+		UMetaHumanCharacter* NewPrototype = NewObject<UMetaHumanCharacter>(
+			GetTransientPackage(),
+			MakeUniqueObjectName(GetTransientPackage(), UMetaHumanCharacter::StaticClass(), TEXT("MetaHumanCharacterPrototype")),
+			RF_Transient
+		);
+		NewPrototype->TemplateType = TemplateType;
+		EditorSubsystem->InitializeMetaHumanCharacter(NewPrototype);
+		Prototype.Reset(NewPrototype);
+
+		OutPrototypeInitSeconds = FPlatformTime::Seconds() - InitStartTime;
+		UE_LOG(LogTemp, Log, TEXT("Initialized %s character prototype in %.2fs"),
+			*UEnum::GetValueAsString(TemplateType), OutPrototypeInitSeconds);
+	}
+
+	// 2. Build complete package path
+	FString PackageNameStr = FPackageName::ObjectPathToPackageName(PackagePath / CharacterName);
+	UPackage* Package = CreatePackage(*PackageNameStr);
+
+	if (!Package)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to create package: %s"), *PackageNameStr);
+		return nullptr;
+	}
+
+	// 3. Copy the prototype (with its internal collection) into the package as a regular asset
+	FObjectDuplicationParameters DuplicationParams = InitStaticDuplicateObjectParams(Prototype.Get(), Package, *CharacterName);
+	DuplicationParams.FlagMask &= ~RF_Transient;
+	DuplicationParams.ApplyFlags |= RF_Public | RF_Standalone;
+	UMetaHumanCharacter* Character = Cast<UMetaHumanCharacter>(StaticDuplicateObjectEx(DuplicationParams));
+
+	if (!Character)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to duplicate MetaHumanCharacter prototype"));
+		return nullptr;
+	}
+
+	// 4. Register character for editing (per character - creates its own editing state)
+	if (!EditorSubsystem->IsObjectAddedForEditing(Character))
+	{
+		if (!EditorSubsystem->TryAddObjectToEdit(Character))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to register character for editing, but continuing..."));
+		}
+	}
+
+	// 5. Mark package as dirty (needs saving)
+	Package->MarkPackageDirty();
+
+	return Character;
+}
+
+void UMetaHumanParametricGenerator::ReleaseCharacterPrototypes()
+{
+	MetaHumanCharacterPrototypes::Prototypes.Reset();
+}
+
+int32 UMetaHumanParametricGenerator::ReleaseCharacter(
+	UMetaHumanCharacter* Character,
+	const TArray<FString>& AssemblyFolders,
+	bool bDiscardUnsaved)
+{
+	if (!Character)
+	{
+		return 0;
+	}
+
+	// The editing state holds the character's preview meshes, textures and rig - drop it first
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+	if (EditorSubsystem && EditorSubsystem->IsObjectAddedForEditing(Character))
+	{
+		EditorSubsystem->RemoveObjectToEdit(Character);
+	}
+
+	TArray<UPackage*> Packages;
+	if (Character->GetPackage() != GetTransientPackage())
+	{
+		Packages.Add(Character->GetPackage());
+	}
+
+	MetaHumanAssemblyPackages::CollectPackagesInFolders(AssemblyFolders, Packages);
+
+	// Nothing references the assets once the job is gone; without RF_Standalone the collector takes them
+	int32 NumReleased = 0;
+	for (UPackage* Package : Packages)
+	{
+		const bool bDiscard = Package->IsDirty();
+		if (bDiscard && !bDiscardUnsaved)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Keeping %s in memory, it has unsaved changes"), *Package->GetName());
+			continue;
+		}
+
+		// A failed or abandoned job never saved these - stray references must not keep the half-built assets alive
+		if (bDiscard)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Discarding unsaved changes of %s"), *Package->GetName());
+			Package->SetDirtyFlag(false);
+		}
+
+		ForEachObjectWithPackage(Package, [bDiscard](UObject* Object)
+		{
+			Object->ClearFlags(RF_Standalone);
+			if (bDiscard)
+			{
+				Object->MarkAsGarbage();
+			}
+			return true;
+		}, /*bIncludeNestedObjects*/ true);
+		++NumReleased;
+	}
+
+	return NumReleased;
+}
+
 // ============================================================================
 // Step 2: Configure Body Parameters (Core!)
 // ============================================================================
@@ -471,6 +1188,65 @@ bool UMetaHumanParametricGenerator::ConfigureBodyParameters(
 		return false;
 	}
 
+	// Everything is applied to one copy of the body state; the mesh is only rebuilt by the commit at the end
+	TSharedRef<FMetaHumanCharacterBodyIdentity::FState> BodyState = EditorSubsystem->CopyBodyState(Character);
+
+	// 1. Set body type (fixed vs parametric)
+	UE_LOG(LogTemp, Log, TEXT("  - Setting body type: %s"),
+		*UEnum::GetValueAsString(BodyConfig.BodyType));
+	BodyState->SetMetaHumanBodyType(BodyConfig.BodyType);
+
+	// 2. Set global deformation strength
+	UE_LOG(LogTemp, Log, TEXT("  - Setting global delta scale: %.2f"), BodyConfig.GlobalDeltaScale);
+	BodyState->SetGlobalDeltaScale(BodyConfig.GlobalDeltaScale);
+
+	// 3. If using parametric body, solve all body constraints at once
+	if (BodyConfig.bUseParametricBody && BodyConfig.BodyMeasurements.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  - Applying parametric body constraints (%d measurements)..."),
+			BodyConfig.BodyMeasurements.Num());
+
+		const TArray<FMetaHumanCharacterBodyConstraint> Constraints =
+			ConvertMeasurementsToConstraints(BodyConfig.BodyMeasurements);
+		BodyState->EvaluateBodyConstraints(Constraints);
+
+		for (const auto& Pair : BodyConfig.BodyMeasurements)
+		{
+			UE_LOG(LogTemp, Log, TEXT("    • %s: %.2f cm"), *Pair.Key, Pair.Value);
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("  - Using fixed body type (no parametric constraints)"));
+	}
+
+	// 4. Single full mesh update + commit
+	EditorSubsystem->CommitBodyState(
+		Character,
+		BodyState,
+		UMetaHumanCharacterEditorSubsystem::EBodyMeshUpdateMode::Full
+	);
+
+	UE_LOG(LogTemp, Log, TEXT("  ✓ Body configuration complete"));
+	return true;
+}
+
+bool UMetaHumanParametricGenerator::ConfigureBodyParametersIncremental(
+	UMetaHumanCharacter* Character,
+	const FMetaHumanBodyParametricConfig& BodyConfig)
+{
+	if (!Character)
+	{
+		return false;
+	}
+
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+	if (!EditorSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to get editor subsystem"));
+		return false;
+	}
+
 	// 1. Set body type (fixed vs parametric)
 	UE_LOG(LogTemp, Log, TEXT("  - Setting body type: %s"),
 		*UEnum::GetValueAsString(BodyConfig.BodyType));
@@ -523,6 +1299,54 @@ bool UMetaHumanParametricGenerator::ConfigureBodyParameters(
 	return true;
 }
 
+bool UMetaHumanParametricGenerator::BenchmarkBodyConfiguration(
+	UMetaHumanCharacter* Character,
+	const FMetaHumanBodyParametricConfig& BodyConfig,
+	int32 Iterations,
+	FMetaHumanBodyBenchmarkResult& OutResult)
+{
+	OutResult = FMetaHumanBodyBenchmarkResult();
+
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
+	if (!Character || !EditorSubsystem || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Invalid arguments for body configuration benchmark"));
+		return false;
+	}
+
+	const TSharedRef<FMetaHumanCharacterBodyIdentity::FState> OriginalState = EditorSubsystem->CopyBodyState(Character);
+
+	// Interleaved so editor warm-up and caches favour neither path
+	double SinglePassSeconds = 0.0;
+	double IncrementalSeconds = 0.0;
+	bool bSuccess = true;
+	for (int32 Iteration = 0; Iteration < Iterations && bSuccess; ++Iteration)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		bSuccess = ConfigureBodyParameters(Character, BodyConfig);
+		SinglePassSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		bSuccess = bSuccess && ConfigureBodyParametersIncremental(Character, BodyConfig);
+		IncrementalSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	EditorSubsystem->CommitBodyState(Character, OriginalState, UMetaHumanCharacterEditorSubsystem::EBodyMeshUpdateMode::Full);
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Body configuration benchmark failed on %s"), *Character->GetName());
+		return false;
+	}
+
+	OutResult.Iterations = Iterations;
+	OutResult.SinglePassMs = SinglePassSeconds * 1000.0 / Iterations;
+	OutResult.IncrementalMs = IncrementalSeconds * 1000.0 / Iterations;
+
+	UE_LOG(LogTemp, Log, TEXT("Body configuration benchmark (%s, %d iterations): single pass %.1f ms, incremental %.1f ms"),
+		*Character->GetName(), Iterations, OutResult.SinglePassMs, OutResult.IncrementalMs);
+	return true;
+}
+
 // ============================================================================
 // Step 3: Configure Appearance (Skin, Eyes, Eyelashes, etc.)
 // ============================================================================
@@ -536,24 +1360,16 @@ bool UMetaHumanParametricGenerator::ConfigureAppearance(
 		return false;
 	}
 
-	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
-	if (!EditorSubsystem)
+	// Staged together so unchanged groups are not regenerated - changed ones still regenerate one by one (see FMetaHumanAppearanceTransaction)
+	FMetaHumanAppearanceTransaction Transaction(Character);
+	Transaction.StageSkin(AppearanceConfig.SkinSettings);
+	Transaction.StageEyes(AppearanceConfig.EyesSettings);
+	Transaction.StageHeadModel(AppearanceConfig.HeadModelSettings);
+	if (!Transaction.Commit())
 	{
 		return false;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("  - Applying skin settings..."));
-	EditorSubsystem->ApplySkinSettings(Character, AppearanceConfig.SkinSettings);
-	EditorSubsystem->CommitSkinSettings(Character, AppearanceConfig.SkinSettings);
-
-	UE_LOG(LogTemp, Log, TEXT("  - Applying eyes settings..."));
-	EditorSubsystem->ApplyEyesSettings(Character, AppearanceConfig.EyesSettings);
-	EditorSubsystem->CommitEyesSettings(Character, AppearanceConfig.EyesSettings);
-
-	UE_LOG(LogTemp, Log, TEXT("  - Applying head model settings..."));
-	EditorSubsystem->ApplyHeadModelSettings(Character, AppearanceConfig.HeadModelSettings);
-	EditorSubsystem->CommitHeadModelSettings(Character, AppearanceConfig.HeadModelSettings);
-
 	UE_LOG(LogTemp, Log, TEXT("  ✓ Appearance configuration complete"));
 	return true;
 }
@@ -589,7 +1405,7 @@ TArray<FMetaHumanCharacterBodyConstraint> UMetaHumanParametricGenerator::Convert
 // Added: Download Texture Source Data
 // ============================================================================
 
-bool UMetaHumanParametricGenerator::DownloadTextureSourceData(UMetaHumanCharacter* Character)
+bool UMetaHumanParametricGenerator::DownloadTextureSourceData(UMetaHumanCharacter* Character, EMetaHumanTextureResolution Resolution)
 {
 	if (!Character)
 	{
@@ -597,6 +1413,12 @@ bool UMetaHumanParametricGenerator::DownloadTextureSourceData(UMetaHumanCharacte
 		return false;
 	}
 
+	if (GetTextureResolutionSize(Resolution) == 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("High-res texture download disabled (%s)"), *UEnum::GetValueAsString(Resolution));
+		return false;
+	}
+
 	// Ensure EditorSubsystem is obtained in the game thread
 	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = getEditorSubsystem();
 
@@ -620,10 +1442,10 @@ bool UMetaHumanParametricGenerator::DownloadTextureSourceData(UMetaHumanCharacte
 		return true;
 	}
 
-	return DownloadTextureSourceData_Impl(Character, EditorSubsystem);
+	return DownloadTextureSourceData_Impl(Character, EditorSubsystem, Resolution);
 }
 
-bool UMetaHumanParametricGenerator::DownloadTextureSourceData_Impl(UMetaHumanCharacter* Character, UMetaHumanCharacterEditorSubsystem* EditorSubsystem)
+bool UMetaHumanParametricGenerator::DownloadTextureSourceData_Impl(UMetaHumanCharacter* Character, UMetaHumanCharacterEditorSubsystem* EditorSubsystem, EMetaHumanTextureResolution Resolution)
 {
 	if (!Character || !EditorSubsystem)
 	{
@@ -646,8 +1468,16 @@ bool UMetaHumanParametricGenerator::DownloadTextureSourceData_Impl(UMetaHumanCha
 	}
 
 	// Step 2: Request texture download
-	UE_LOG(LogTemp, Log, TEXT("Requesting 2k texture download..."));
-	EditorSubsystem->RequestHighResolutionTextures(Character, ERequestTextureResolution::Res2k);
+	ERequestTextureResolution RequestResolution = ERequestTextureResolution::Res2k;
+	switch (Resolution)
+	{
+		case EMetaHumanTextureResolution::Res4k: RequestResolution = ERequestTextureResolution::Res4k; break;
+		case EMetaHumanTextureResolution::Res8k: RequestResolution = ERequestTextureResolution::Res8k; break;
+		default: break;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Requesting %dpx texture download..."), GetTextureResolutionSize(Resolution));
+	EditorSubsystem->RequestHighResolutionTextures(Character, RequestResolution);
 
 	// Wait for download to complete
 	bool bDownloadStarted = false;
@@ -670,6 +1500,52 @@ bool UMetaHumanParametricGenerator::DownloadTextureSourceData_Impl(UMetaHumanCha
 	}
 }
 
+// ============================================================================
+// Texture Resolution Policy
+// ============================================================================
+
+EMetaHumanTextureResolution UMetaHumanParametricGenerator::GetTextureResolutionForQuality(EMetaHumanQualityLevel QualityLevel)
+{
+	switch (QualityLevel)
+	{
+		case EMetaHumanQualityLevel::Cinematic:
+		case EMetaHumanQualityLevel::High:
+			return EMetaHumanTextureResolution::Res2k;
+		default:
+			return EMetaHumanTextureResolution::None;
+	}
+}
+
+EMetaHumanTextureResolution UMetaHumanParametricGenerator::ResolveTextureResolution(EMetaHumanTextureResolution Resolution, EMetaHumanQualityLevel QualityLevel)
+{
+	return Resolution == EMetaHumanTextureResolution::FromQuality ? GetTextureResolutionForQuality(QualityLevel) : Resolution;
+}
+
+EMetaHumanTextureResolution UMetaHumanParametricGenerator::ResolveTextureResolution(EMetaHumanTextureResolution Resolution, const TArray<EMetaHumanQualityLevel>& QualityLevels)
+{
+	EMetaHumanTextureResolution Largest = EMetaHumanTextureResolution::None;
+	for (const EMetaHumanQualityLevel QualityLevel : QualityLevels)
+	{
+		const EMetaHumanTextureResolution LevelResolution = ResolveTextureResolution(Resolution, QualityLevel);
+		if (GetTextureResolutionSize(LevelResolution) > GetTextureResolutionSize(Largest))
+		{
+			Largest = LevelResolution;
+		}
+	}
+	return Largest;
+}
+
+int32 UMetaHumanParametricGenerator::GetTextureResolutionSize(EMetaHumanTextureResolution Resolution)
+{
+	switch (Resolution)
+	{
+		case EMetaHumanTextureResolution::Res2k: return 2048;
+		case EMetaHumanTextureResolution::Res4k: return 4096;
+		case EMetaHumanTextureResolution::Res8k: return 8192;
+		default: return 0;
+	}
+}
+
 
 
 // ============================================================================
@@ -972,7 +1848,13 @@ bool UMetaHumanParametricGenerator::AddWardrobeItem(
 	FSoftObjectPath SoftPath(WardrobeItemPath);
 	TSoftObjectPtr<UMetaHumanWardrobeItem> WardrobeItemRef{ SoftPath };
 
-	UMetaHumanWardrobeItem* WardrobeItem = WardrobeItemRef.LoadSynchronous();
+	// Already resident when the batch preloaded its wardrobe (FMetaHumanWardrobePreloader), otherwise a blocking load
+	UMetaHumanWardrobeItem* WardrobeItem = WardrobeItemRef.Get();
+	if (!WardrobeItem)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Wardrobe item not preloaded, loading synchronously: %s"), *WardrobeItemPath);
+		WardrobeItem = WardrobeItemRef.LoadSynchronous();
+	}
 	if (!WardrobeItem)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to load wardrobe item from path: %s"), *WardrobeItemPath);
@@ -1095,36 +1977,12 @@ bool UMetaHumanParametricGenerator::RemoveWardrobeItem(UMetaHumanCharacter* Char
 
 FString UMetaHumanParametricGenerator::GetRandomWardrobeItemFromPath(const FName& SlotName, const FString& ContentPath)
 {
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	FARFilter Filter;
-	Filter.PackagePaths.Add(*ContentPath);
-	Filter.ClassPaths.Add(UMetaHumanWardrobeItem::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssets(Filter, AssetDataList);
-
-	if (AssetDataList.Num() == 0)
+	// Indexed once and kept current from asset registry events, so no registry query per call
+	const FString AssetPath = FMetaHumanWardrobeCatalog::Get().PickRandom(SlotName, ContentPath);
+	if (!AssetPath.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("No wardrobe items found in path: %s"), *ContentPath);
-		return FString();
+		UE_LOG(LogTemp, Log, TEXT("Randomly selected wardrobe item for slot %s: %s"), *SlotName.ToString(), *AssetPath);
 	}
-
-	int32 RandomIndex = FMath::RandRange(0, AssetDataList.Num() - 1);
-	const FAssetData& SelectedAsset = AssetDataList[RandomIndex];
-
-	FString AssetPath = SelectedAsset.GetSoftObjectPath().ToString();
-	// print all wardrobe items
-	UE_LOG(LogTemp, Log, TEXT("All wardrobe items in path %s:"), *ContentPath);
-	for (const FAssetData& Asset : AssetDataList)
-	{
-		UE_LOG(LogTemp, Log, TEXT("%s"), *Asset.GetSoftObjectPath().ToString());
-	}
-	UE_LOG(LogTemp, Log, TEXT("Randomly selected wardrobe item [%d/%d]: %s"), 
-		RandomIndex + 1, AssetDataList.Num(), *AssetPath);
-
 	return AssetPath;
 }
 
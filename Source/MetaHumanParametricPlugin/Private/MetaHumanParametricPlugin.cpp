@@ -4,11 +4,14 @@
 #include "MetaHumanParametricGenerator.h"
 #include "MetaHumanBlueprintExporter.h"
 #include "EditorBatchGenerationSubsystem.h"
+#include "MetaHumanWardrobeCatalog.h"
+#include "MetaHumanAssemblyPipelineManager.h"
 #include "LevelEditor.h"
 #include "ToolMenus.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Editor.h"
+#include "Misc/CommandLine.h"
 
 #define LOCTEXT_NAMESPACE "FMetaHumanParametricPluginModule"
 
@@ -21,8 +24,11 @@ void FMetaHumanParametricPluginModule::StartupModule()
 {
 	UE_LOG(LogTemp, Log, TEXT("MetaHumanParametricPlugin module has been loaded"));
 
-	// Register menu extensions
-	RegisterMenuExtensions();
+	// Register menu extensions (there is no level editor when running as a commandlet)
+	if (!IsRunningCommandlet())
+	{
+		RegisterMenuExtensions();
+	}
 
 	// Initialize heartbeat system
 	InitializeHeartbeat();
@@ -37,6 +43,10 @@ void FMetaHumanParametricPluginModule::ShutdownModule()
 		FTSTicker::GetCoreTicker().RemoveTicker(HeartbeatTickerHandle);
 	}
 
+	FMetaHumanWardrobeCatalog::TearDown();
+	UMetaHumanParametricGenerator::ReleaseCharacterPrototypes();
+	UMetaHumanAssemblyPipelineManager::ResetPipelineCache();
+
 	UE_LOG(LogTemp, Log, TEXT("MetaHumanParametricPlugin module has been unloaded"));
 }
 
@@ -107,6 +117,15 @@ void FMetaHumanParametricPluginModule::AddToolbarExtension()
 				FSlateIcon(),
 				FUIAction(FExecuteAction::CreateStatic(&FMetaHumanParametricPluginModule::OnExportWithAnimBP))
 			);
+
+			// Benchmark body configuration
+			TwoStepSection.AddMenuEntry(
+				"BenchmarkBody",
+				LOCTEXT("BenchmarkBodyLabel", "Benchmark Body Configuration"),
+				LOCTEXT("BenchmarkBodyTooltip", "Time the single-pass body configuration against the incremental one on the Step 1 character (body is restored afterwards)"),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateStatic(&FMetaHumanParametricPluginModule::OnBenchmarkBodyConfiguration))
+			);
 		}),
 		false,
 		FSlateIcon(FAppStyle::GetAppStyleSetName(), "LevelEditor.Tabs.Details")
@@ -323,15 +342,9 @@ void FMetaHumanParametricPluginModule::OnTestAuthentication()
 // Two-Step Workflow Callbacks
 // ============================================================================
 
-void FMetaHumanParametricPluginModule::OnStep1PrepareAndRig()
+/** Body of the Two-Step example character: slender female */
+static FMetaHumanBodyParametricConfig MakeTwoStepBodyConfig()
 {
-	UE_LOG(LogTemp, Warning, TEXT("=== Two-Step Workflow: Step 1 - Prepare & Rig ==="));
-
-	FNotificationInfo Info(LOCTEXT("Step1Starting", "Step 1: Preparing and starting AutoRig..."));
-	Info.ExpireDuration = 3.0f;
-	FSlateNotificationManager::Get().AddNotification(Info);
-
-	// Create a slender female character as example
 	FMetaHumanBodyParametricConfig BodyConfig;
 	BodyConfig.BodyType = EMetaHumanBodyType::f_med_nrw;
 	BodyConfig.GlobalDeltaScale = 1.0f;
@@ -340,6 +353,19 @@ void FMetaHumanParametricPluginModule::OnStep1PrepareAndRig()
 	BodyConfig.BodyMeasurements.Add(TEXT("Waist"), 62.0f);
 	BodyConfig.BodyMeasurements.Add(TEXT("Chest"), 85.0f);
 	BodyConfig.QualityLevel = EMetaHumanQualityLevel::Cinematic;
+	return BodyConfig;
+}
+
+void FMetaHumanParametricPluginModule::OnStep1PrepareAndRig()
+{
+	UE_LOG(LogTemp, Warning, TEXT("=== Two-Step Workflow: Step 1 - Prepare & Rig ==="));
+
+	FNotificationInfo Info(LOCTEXT("Step1Starting", "Step 1: Preparing and starting AutoRig..."));
+	Info.ExpireDuration = 3.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	// Create a slender female character as example
+	const FMetaHumanBodyParametricConfig BodyConfig = MakeTwoStepBodyConfig();
 
 	FMetaHumanAppearanceConfig AppearanceConfig;
 
@@ -409,6 +435,34 @@ void FMetaHumanParametricPluginModule::OnCheckRiggingStatus()
 	FSlateNotificationManager::Get().AddNotification(StatusInfo);
 }
 
+void FMetaHumanParametricPluginModule::OnBenchmarkBodyConfiguration()
+{
+	if (!LastGeneratedCharacter)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No character from Step 1 - please run Step 1 first"));
+
+		FNotificationInfo WarningInfo(LOCTEXT("NoCharacter", "No character found - please run Step 1 first"));
+		WarningInfo.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(WarningInfo);
+		return;
+	}
+
+	FMetaHumanBodyBenchmarkResult Result;
+	if (!UMetaHumanParametricGenerator::BenchmarkBodyConfiguration(LastGeneratedCharacter, MakeTwoStepBodyConfig(), 10, Result))
+	{
+		FNotificationInfo ErrorInfo(LOCTEXT("BenchmarkBodyFailed", "Body configuration benchmark failed - Check Output Log"));
+		ErrorInfo.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(ErrorInfo);
+		return;
+	}
+
+	FString NotificationText = FString::Printf(TEXT("Body configuration: single pass %.1f ms, incremental %.1f ms (%d runs)"),
+		Result.SinglePassMs, Result.IncrementalMs, Result.Iterations);
+	FNotificationInfo ResultInfo(FText::FromString(NotificationText));
+	ResultInfo.ExpireDuration = 7.0f;
+	FSlateNotificationManager::Get().AddNotification(ResultInfo);
+}
+
 void FMetaHumanParametricPluginModule::OnStep2Assemble()
 {
 	if (!LastGeneratedCharacter)
@@ -556,16 +610,25 @@ void FMetaHumanParametricPluginModule::OnCheckBatchStatus()
 	EBatchGenState State;
 	FString CharacterName;
 	int32 Count;
-	BatchSubsystem->GetStatusInfo(State, CharacterName, Count);
+	FMetaHumanBatchMetricsSnapshot Metrics;
+	BatchSubsystem->GetStatusInfo(State, CharacterName, Count, Metrics);
 
 	FString StateString = BatchSubsystem->GetCurrentStateString();
 
 	UE_LOG(LogTemp, Log, TEXT("Current State: %s"), *StateString);
 	UE_LOG(LogTemp, Log, TEXT("Current Character: %s"), CharacterName.IsEmpty() ? TEXT("None") : *CharacterName);
 	UE_LOG(LogTemp, Log, TEXT("Characters Generated: %d"), Count);
+	UE_LOG(LogTemp, Log, TEXT("Characters Failed: %d"), Metrics.CharactersFailed);
+	UE_LOG(LogTemp, Log, TEXT("Throughput: %.1f characters/hour"), Metrics.CharactersPerHour);
+	for (const FMetaHumanStageMetricsSnapshot& Stage : Metrics.Stages)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %-18s ok %4d  fail %4d  p50 %7.1fs  p95 %7.1fs  p99 %7.1fs"),
+			*Stage.Stage.ToString(), Stage.SuccessCount, Stage.FailureCount,
+			Stage.P50Seconds, Stage.P95Seconds, Stage.P99Seconds);
+	}
 
-	FString StatusMessage = FString::Printf(TEXT("State: %s | Count: %d | Current: %s"),
-		*StateString, Count, CharacterName.IsEmpty() ? TEXT("None") : *CharacterName);
+	FString StatusMessage = FString::Printf(TEXT("State: %s | Count: %d | %.1f/h | Current: %s"),
+		*StateString, Count, Metrics.CharactersPerHour, CharacterName.IsEmpty() ? TEXT("None") : *CharacterName);
 
 	FNotificationInfo StatusInfo(FText::FromString(StatusMessage));
 	StatusInfo.ExpireDuration = 5.0f;
@@ -666,6 +729,9 @@ void FMetaHumanParametricPluginModule::InitializeHeartbeat()
 {
 	HeartbeatFilePath = FPaths::ProjectSavedDir() / TEXT("heartbeat.txt");
 
+	// Several workers of one project need their own file so each monitor watches its own process
+	FParse::Value(FCommandLine::Get(), TEXT("HeartbeatFile="), HeartbeatFilePath);
+
 	UE_LOG(LogTemp, Warning, TEXT("Heartbeat: Initializing at %s"), *HeartbeatFilePath);
 
 	HeartbeatValue = 0;
@@ -692,7 +758,11 @@ bool FMetaHumanParametricPluginModule::TickHeartbeat(float DeltaTime)
 		UE_LOG(LogTemp, Log, TEXT("Heartbeat: [%u] written to file"), HeartbeatValue);
 
 		// Auto-start batch generation after 20 seconds
-		AutoStartBatchGeneration();
+		// The batch commandlet starts its own batch and must exit when it is done
+		if (!IsRunningCommandlet())
+		{
+			AutoStartBatchGeneration();
+		}
 	}
 
 	return true;
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Rig Cache - Implementation
+
+#include "MetaHumanRigCache.h"
+#include "MetaHumanAtomicFile.h"
+#include "MetaHumanCharacter.h"
+#include "MetaHumanCharacterEditorSubsystem.h"
+#include "MetaHumanCharacterIdentity.h"
+#include "DNAUtils.h"
+#include "DNAReader.h"
+#include "Editor.h"
+#include "Misc/SecureHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace MetaHumanRigCache
+{
+	/** Bump when the key layout or the stored data changes - old entries are then never hit */
+	static const FString FormatVersion = TEXT("1");
+
+	/** Rig type requested by UMetaHumanParametricGenerator::StartAutoRig */
+	static const FString RigTypeName = TEXT("JointsAndBlendshapes");
+
+	static UMetaHumanCharacterEditorSubsystem* GetEditorSubsystem()
+	{
+		return GEditor ? GEditor->GetEditorSubsystem<UMetaHumanCharacterEditorSubsystem>() : nullptr;
+	}
+}
+
+FString FMetaHumanRigCache::ComputeKey(UMetaHumanCharacter* Character)
+{
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = MetaHumanRigCache::GetEditorSubsystem();
+	if (!Character || !EditorSubsystem)
+	{
+		return FString();
+	}
+
+	// The live state, not the one last committed to the asset - it is what AutoRig would send
+	FSharedBuffer FaceStateData;
+	EditorSubsystem->GetFaceState(Character)->Serialize(FaceStateData);
+	if (FaceStateData.IsNull() || FaceStateData.GetSize() == 0)
+	{
+		return FString();
+	}
+
+	const FString Header = MetaHumanRigCache::FormatVersion + TEXT("|") + MetaHumanRigCache::RigTypeName + TEXT("|");
+	const FTCHARToUTF8 HeaderUtf8(*Header);
+
+	FSHA1 Sha;
+	Sha.Update(reinterpret_cast<const uint8*>(HeaderUtf8.Get()), HeaderUtf8.Length());
+	Sha.Update(static_cast<const uint8*>(FaceStateData.GetData()), FaceStateData.GetSize());
+	Sha.Final();
+
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+bool FMetaHumanRigCache::TryApply(UMetaHumanCharacter* Character, const FString& Key)
+{
+	UMetaHumanCharacterEditorSubsystem* EditorSubsystem = MetaHumanRigCache::GetEditorSubsystem();
+	if (!Character || !EditorSubsystem || Key.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString EntryPath = GetEntryPath(Key);
+	TArray<uint8> DNABuffer;
+	if (!FFileHelper::LoadFileToArray(DNABuffer, *EntryPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	TSharedPtr<IDNAReader> DNAReader = ReadDNAFromBuffer(&DNABuffer, EDNADataLayer::All);
+	if (!DNAReader.IsValid())
+	{
+		// Truncated or from an incompatible DNA version - drop it so AutoRig refills it
+		UE_LOG(LogTemp, Warning, TEXT("[RigCache] Discarding unreadable entry %s"), *EntryPath);
+		IFileManager::Get().Delete(*EntryPath);
+		return false;
+	}
+
+	Character->Modify();
+	EditorSubsystem->CommitFaceDNA(Character, DNAReader.ToSharedRef());
+
+	UE_LOG(LogTemp, Log, TEXT("[RigCache] Applied cached rig %s to %s"), *Key, *Character->GetName());
+	return Character->HasFaceDNA();
+}
+
+bool FMetaHumanRigCache::Store(UMetaHumanCharacter* Character, const FString& Key)
+{
+	if (!Character || !Character->HasFaceDNA() || Key.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString EntryPath = GetEntryPath(Key);
+	IFileManager& FileManager = IFileManager::Get();
+	if (FileManager.FileExists(*EntryPath))
+	{
+		return true;
+	}
+
+	const TArray<uint8> DNABuffer = Character->GetFaceDNABuffer();
+	if (DNABuffer.IsEmpty())
+	{
+		return false;
+	}
+
+	if (!FMetaHumanAtomicFile::SaveArray(DNABuffer, EntryPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RigCache] Failed to store rig %s"), *EntryPath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[RigCache] Stored rig of %s as %s (%d bytes)"), *Character->GetName(), *Key, DNABuffer.Num());
+	return true;
+}
+
+FString FMetaHumanRigCache::GetCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("RigCache"));
+}
+
+FString FMetaHumanRigCache::GetEntryPath(const FString& Key)
+{
+	return FPaths::Combine(GetCacheDirectory(), Key + TEXT(".dna"));
+}
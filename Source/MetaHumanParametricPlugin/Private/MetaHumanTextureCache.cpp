@@ -0,0 +1,325 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Texture Cache - Implementation
+
+#include "MetaHumanTextureCache.h"
+#include "MetaHumanAtomicFile.h"
+#include "MetaHumanCharacter.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace MetaHumanTextureCache
+{
+	/** Bump when the key layout or the entry format changes - old entries are then never hit */
+	static const FString FormatVersion = TEXT("1");
+
+	static const uint32 EntryMagic = 0x4354484D; // "MHTC"
+
+	static const TCHAR* EntryExtension = TEXT("mhtex");
+
+	/** One texture of an entry, as stored on disk */
+	struct FCachedTexture
+	{
+		uint8 Type = 0;
+		FImage Image;
+	};
+
+	/** Skin tone is compared bit-exact, so the key does not depend on float formatting */
+	static FString MakeKey(const TCHAR* Kind, int32 TextureIndex, const UMetaHumanCharacter* Character, int32 Resolution)
+	{
+		const FMetaHumanCharacterSkinProperties& Skin = Character->SkinSettings.Skin;
+		return FString::Printf(TEXT("v%s_%s_%03d_%08X_%08X_%d"),
+			*FormatVersion, Kind, TextureIndex,
+			FMath::AsUInt(Skin.U), FMath::AsUInt(Skin.V),
+			Resolution);
+	}
+
+	static bool WriteEntry(const FString& EntryPath, const TArray<FCachedTexture>& Textures)
+	{
+		return FMetaHumanAtomicFile::Write(EntryPath, [&Textures](const FString& TempFilePath)
+		{
+			TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+			if (!Writer)
+			{
+				return false;
+			}
+
+			uint32 Magic = EntryMagic;
+			int32 NumTextures = Textures.Num();
+			*Writer << Magic << NumTextures;
+			for (const FCachedTexture& Texture : Textures)
+			{
+				uint8 Type = Texture.Type;
+				int32 SizeX = Texture.Image.SizeX;
+				int32 SizeY = Texture.Image.SizeY;
+				int32 NumSlices = Texture.Image.NumSlices;
+				uint8 Format = static_cast<uint8>(Texture.Image.Format);
+				uint8 GammaSpace = static_cast<uint8>(Texture.Image.GammaSpace);
+				int64 NumBytes = Texture.Image.RawData.Num();
+				*Writer << Type << SizeX << SizeY << NumSlices << Format << GammaSpace << NumBytes;
+				Writer->Serialize(const_cast<uint8*>(Texture.Image.RawData.GetData()), NumBytes);
+			}
+
+			// Closed before the rename, the handle would keep the file locked
+			return Writer->Close();
+		});
+	}
+
+	static bool ReadEntry(const FString& EntryPath, TArray<FCachedTexture>& OutTextures)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*EntryPath, FILEREAD_Silent));
+		if (!Reader)
+		{
+			return false;
+		}
+
+		uint32 Magic = 0;
+		int32 NumTextures = 0;
+		*Reader << Magic << NumTextures;
+		if (Magic != EntryMagic || NumTextures <= 0)
+		{
+			return false;
+		}
+
+		OutTextures.SetNum(NumTextures);
+		for (FCachedTexture& Texture : OutTextures)
+		{
+			int32 SizeX = 0;
+			int32 SizeY = 0;
+			int32 NumSlices = 0;
+			uint8 Format = 0;
+			uint8 GammaSpace = 0;
+			int64 NumBytes = 0;
+			*Reader << Texture.Type << SizeX << SizeY << NumSlices << Format << GammaSpace << NumBytes;
+			if (Reader->IsError() || SizeX <= 0 || SizeY <= 0 || NumSlices <= 0)
+			{
+				return false;
+			}
+
+			Texture.Image.Init(SizeX, SizeY, NumSlices, static_cast<ERawImageFormat::Type>(Format), static_cast<EGammaSpace>(GammaSpace));
+			if (Texture.Image.RawData.Num() != NumBytes)
+			{
+				return false;
+			}
+			Reader->Serialize(Texture.Image.RawData.GetData(), NumBytes);
+		}
+
+		return !Reader->IsError();
+	}
+
+	/** Copy the stored high-resolution data of every texture in InfoMap */
+	template<typename TTextureType, typename TGetData>
+	static bool CollectTextures(const TMap<TTextureType, FMetaHumanCharacterTextureInfo>& InfoMap, int32 Resolution, TGetData GetData, TArray<FCachedTexture>& OutTextures)
+	{
+		for (const TPair<TTextureType, FMetaHumanCharacterTextureInfo>& Pair : InfoMap)
+		{
+			const FMetaHumanCharacterTextureInfo& Info = Pair.Value;
+			if (Info.SizeX < Resolution)
+			{
+				// Only the low resolution synthesized version is there - nothing worth caching
+				return false;
+			}
+
+			const FSharedBuffer Data = GetData(Pair.Key);
+			FCachedTexture& Texture = OutTextures.AddDefaulted_GetRef();
+			Texture.Type = static_cast<uint8>(Pair.Key);
+			Texture.Image.Init(Info.SizeX, Info.SizeY, Info.NumSlices, Info.Format, Info.GammaSpace);
+			if (Data.IsNull() || static_cast<int64>(Data.GetSize()) != Texture.Image.RawData.Num())
+			{
+				return false;
+			}
+			FMemory::Memcpy(Texture.Image.RawData.GetData(), Data.GetData(), Data.GetSize());
+		}
+		return OutTextures.Num() > 0;
+	}
+
+	/** Point the preview texture object at the new source data, as the download completion does */
+	static void UpdatePreviewTexture(UTexture2D* Texture, const FImage& Image)
+	{
+		if (Texture)
+		{
+			Texture->Source.Init(Image);
+			Texture->UpdateResource();
+		}
+	}
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+FString FMetaHumanTextureCache::GetFaceKey(const UMetaHumanCharacter* Character, int32 Resolution)
+{
+	return Character ? MetaHumanTextureCache::MakeKey(TEXT("Face"), Character->SkinSettings.Skin.FaceTextureIndex, Character, Resolution) : FString();
+}
+
+FString FMetaHumanTextureCache::GetBodyKey(const UMetaHumanCharacter* Character, int32 Resolution)
+{
+	return Character ? MetaHumanTextureCache::MakeKey(TEXT("Body"), Character->SkinSettings.Skin.BodyTextureIndex, Character, Resolution) : FString();
+}
+
+bool FMetaHumanTextureCache::TryApply(UMetaHumanCharacter* Character, int32 Resolution)
+{
+	using namespace MetaHumanTextureCache;
+
+	if (!Character)
+	{
+		return false;
+	}
+
+	const FString FacePath = GetEntryPath(GetFaceKey(Character, Resolution));
+	const FString BodyPath = GetEntryPath(GetBodyKey(Character, Resolution));
+
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FileManager.FileExists(*FacePath) || !FileManager.FileExists(*BodyPath))
+	{
+		return false;
+	}
+
+	TArray<FCachedTexture> FaceTextures;
+	TArray<FCachedTexture> BodyTextures;
+	if (!ReadEntry(FacePath, FaceTextures) || !ReadEntry(BodyPath, BodyTextures))
+	{
+		// Truncated or from an older format - drop both so the next download refills them
+		UE_LOG(LogTemp, Warning, TEXT("[TextureCache] Discarding unreadable entries %s / %s"), *FacePath, *BodyPath);
+		FileManager.Delete(*FacePath);
+		FileManager.Delete(*BodyPath);
+		return false;
+	}
+
+	Character->Modify();
+	for (const FCachedTexture& Texture : FaceTextures)
+	{
+		const EFaceTextureType Type = static_cast<EFaceTextureType>(Texture.Type);
+		Character->StoreSynthesizedFaceTexture(Type, Texture.Image);
+		UpdatePreviewTexture(Character->SynthesizedFaceTextures.FindRef(Type), Texture.Image);
+	}
+	for (const FCachedTexture& Texture : BodyTextures)
+	{
+		const EBodyTextureType Type = static_cast<EBodyTextureType>(Texture.Type);
+		Character->StoreHighResBodyTexture(Type, Texture.Image);
+		UpdatePreviewTexture(Character->BodyTextures.FindRef(Type), Texture.Image);
+	}
+
+	// Used just now - move both to the back of the eviction order
+	const FDateTime Now = FDateTime::UtcNow();
+	FileManager.SetTimeStamp(*FacePath, Now);
+	FileManager.SetTimeStamp(*BodyPath, Now);
+
+	UE_LOG(LogTemp, Log, TEXT("[TextureCache] Applied %d face and %d body textures to %s"),
+		FaceTextures.Num(), BodyTextures.Num(), *Character->GetName());
+	return Character->HasHighResolutionTextures();
+}
+
+// ============================================================================
+// Storage
+// ============================================================================
+
+bool FMetaHumanTextureCache::Store(UMetaHumanCharacter* Character, int32 Resolution, int64 MaxCacheBytes, int32& OutEvictedCount)
+{
+	using namespace MetaHumanTextureCache;
+
+	OutEvictedCount = 0;
+	if (!Character || !Character->HasHighResolutionTextures())
+	{
+		return false;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString FacePath = GetEntryPath(GetFaceKey(Character, Resolution));
+	const FString BodyPath = GetEntryPath(GetBodyKey(Character, Resolution));
+	bool bStoredAny = false;
+
+	if (!FileManager.FileExists(*FacePath))
+	{
+		TArray<FCachedTexture> FaceTextures;
+		const bool bCollected = CollectTextures(Character->SynthesizedFaceTexturesInfo, Resolution,
+			[Character](EFaceTextureType Type) { return Character->GetSynthesizedFaceTextureDataAsync(Type).Get(); },
+			FaceTextures);
+		if (!bCollected || !WriteEntry(FacePath, FaceTextures))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[TextureCache] Failed to store face textures of %s"), *Character->GetName());
+			return false;
+		}
+		bStoredAny = true;
+	}
+
+	if (!FileManager.FileExists(*BodyPath))
+	{
+		TArray<FCachedTexture> BodyTextures;
+		const bool bCollected = CollectTextures(Character->HighResBodyTexturesInfo, Resolution,
+			[Character](EBodyTextureType Type) { return Character->GetHighResBodyTextureDataAsync(Type).Get(); },
+			BodyTextures);
+		if (!bCollected || !WriteEntry(BodyPath, BodyTextures))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[TextureCache] Failed to store body textures of %s"), *Character->GetName());
+			return false;
+		}
+		bStoredAny = true;
+	}
+
+	if (bStoredAny)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[TextureCache] Stored textures of %s"), *Character->GetName());
+		OutEvictedCount = Trim(MaxCacheBytes);
+	}
+	return true;
+}
+
+int32 FMetaHumanTextureCache::Trim(int64 MaxCacheBytes)
+{
+	struct FEntryFile
+	{
+		FString Path;
+		int64 Size = 0;
+		FDateTime LastUsed;
+	};
+
+	TArray<FEntryFile> Entries;
+	int64 TotalBytes = 0;
+	IFileManager::Get().IterateDirectoryStat(*GetCacheDirectory(), [&Entries, &TotalBytes](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory && FPaths::GetExtension(FilenameOrDirectory) == MetaHumanTextureCache::EntryExtension)
+		{
+			Entries.Add({ FilenameOrDirectory, StatData.FileSize, StatData.ModificationTime });
+			TotalBytes += StatData.FileSize;
+		}
+		return true;
+	});
+
+	if (TotalBytes <= MaxCacheBytes)
+	{
+		return 0;
+	}
+
+	Entries.Sort([](const FEntryFile& A, const FEntryFile& B) { return A.LastUsed < B.LastUsed; });
+
+	int32 EvictedCount = 0;
+	for (const FEntryFile& Entry : Entries)
+	{
+		if (TotalBytes <= MaxCacheBytes)
+		{
+			break;
+		}
+		if (IFileManager::Get().Delete(*Entry.Path, false, false, true))
+		{
+			TotalBytes -= Entry.Size;
+			EvictedCount++;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[TextureCache] Evicted %d entries, %.1f MB left"), EvictedCount, TotalBytes / (1024.0 * 1024.0));
+	return EvictedCount;
+}
+
+FString FMetaHumanTextureCache::GetCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("TextureCache"));
+}
+
+FString FMetaHumanTextureCache::GetEntryPath(const FString& Key)
+{
+	return FPaths::Combine(GetCacheDirectory(), Key + TEXT(".") + MetaHumanTextureCache::EntryExtension);
+}
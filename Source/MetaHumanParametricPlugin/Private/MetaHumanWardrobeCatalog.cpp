@@ -0,0 +1,324 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Wardrobe Catalog - Implementation
+
+#include "MetaHumanWardrobeCatalog.h"
+#include "MetaHumanWardrobeItem.h"
+#include "MetaHumanAtomicFile.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace MetaHumanWardrobeCatalog
+{
+	/** First line of the catalog file - bump when the format changes, old files are then rebuilt */
+	static const FString FileHeader = TEXT("MHWardrobeCatalog 1");
+
+	static FString GetFolder(const FSoftObjectPath& ItemPath)
+	{
+		return FPackageName::GetLongPackagePath(ItemPath.GetLongPackageName());
+	}
+
+	static bool IsUnderRoot(const FString& Folder, const FString& Root)
+	{
+		return Folder == Root || (Folder.StartsWith(Root) && Folder.Len() > Root.Len() && Folder[Root.Len()] == TEXT('/'));
+	}
+
+	static FString NormalizeRoot(const FString& ContentPath)
+	{
+		FString Root = ContentPath;
+		Root.RemoveFromEnd(TEXT("/"));
+		return Root;
+	}
+
+	static FString MakeQueryKey(const FName& SlotName, const FString& Root)
+	{
+		return SlotName.ToString() + TEXT("|") + Root;
+	}
+
+	static FString GetQueryRoot(const FString& QueryKey)
+	{
+		FString Slot, Root;
+		QueryKey.Split(TEXT("|"), &Slot, &Root);
+		return Root;
+	}
+}
+
+TUniquePtr<FMetaHumanWardrobeCatalog> FMetaHumanWardrobeCatalog::Instance;
+
+FMetaHumanWardrobeCatalog& FMetaHumanWardrobeCatalog::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance.Reset(new FMetaHumanWardrobeCatalog());
+	}
+	return *Instance;
+}
+
+void FMetaHumanWardrobeCatalog::TearDown()
+{
+	Instance.Reset();
+}
+
+FMetaHumanWardrobeCatalog::FMetaHumanWardrobeCatalog()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMetaHumanWardrobeCatalog::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMetaHumanWardrobeCatalog::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMetaHumanWardrobeCatalog::HandleAssetRenamed);
+
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		// Answer from the last session's index while the registry scans, reconcile when it is done
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FMetaHumanWardrobeCatalog::HandleFilesLoaded);
+		if (!LoadFromFile())
+		{
+			RebuildFromRegistry();
+		}
+	}
+	else
+	{
+		RebuildFromRegistry();
+	}
+}
+
+FMetaHumanWardrobeCatalog::~FMetaHumanWardrobeCatalog()
+{
+	SaveIfDirty();
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+const TArray<FSoftObjectPath>& FMetaHumanWardrobeCatalog::GetItems(const FName& SlotName, const FString& ContentPath)
+{
+	using namespace MetaHumanWardrobeCatalog;
+
+	const FString Root = NormalizeRoot(ContentPath);
+	const FString QueryKey = MakeQueryKey(SlotName, Root);
+	if (const TArray<FSoftObjectPath>* Cached = QueryCache.Find(QueryKey))
+	{
+		return *Cached;
+	}
+
+	TArray<FSoftObjectPath>& Items = QueryCache.Add(QueryKey);
+	for (const TPair<FString, TArray<FSoftObjectPath>>& Folder : ItemsByFolder)
+	{
+		if (IsUnderRoot(Folder.Key, Root))
+		{
+			Items.Append(Folder.Value);
+		}
+	}
+
+	// Map order is not stable across sessions - sort so a seeded pick is
+	Items.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B)
+	{
+		return A.ToString() < B.ToString();
+	});
+	return Items;
+}
+
+FString FMetaHumanWardrobeCatalog::PickRandom(const FName& SlotName, const FString& ContentPath, FRandomStream* Stream)
+{
+	const TArray<FSoftObjectPath>& Items = GetItems(SlotName, ContentPath);
+	if (Items.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[WardrobeCatalog] No wardrobe items found in path: %s"), *ContentPath);
+		return FString();
+	}
+
+	const int32 Index = Stream ? Stream->RandRange(0, Items.Num() - 1) : FMath::RandRange(0, Items.Num() - 1);
+	return Items[Index].ToString();
+}
+
+int32 FMetaHumanWardrobeCatalog::Num() const
+{
+	int32 Count = 0;
+	for (const TPair<FString, TArray<FSoftObjectPath>>& Folder : ItemsByFolder)
+	{
+		Count += Folder.Value.Num();
+	}
+	return Count;
+}
+
+// ============================================================================
+// Index
+// ============================================================================
+
+void FMetaHumanWardrobeCatalog::RebuildFromRegistry()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> AssetDataList;
+	AssetRegistry.GetAssetsByClass(UMetaHumanWardrobeItem::StaticClass()->GetClassPathName(), AssetDataList, /*bSearchSubClasses*/ true);
+
+	ItemsByFolder.Reset();
+	QueryCache.Reset();
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		AddItem(AssetData.GetSoftObjectPath());
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[WardrobeCatalog] Indexed %d wardrobe item(s) in %d folder(s)"), Num(), ItemsByFolder.Num());
+	bDirty = true;
+	SaveIfDirty();
+}
+
+void FMetaHumanWardrobeCatalog::AddItem(const FSoftObjectPath& ItemPath)
+{
+	TArray<FSoftObjectPath>& FolderItems = ItemsByFolder.FindOrAdd(MetaHumanWardrobeCatalog::GetFolder(ItemPath));
+	if (!FolderItems.Contains(ItemPath))
+	{
+		FolderItems.Add(ItemPath);
+		InvalidateQueries(ItemPath);
+		bDirty = true;
+	}
+}
+
+void FMetaHumanWardrobeCatalog::RemoveItem(const FSoftObjectPath& ItemPath)
+{
+	const FString Folder = MetaHumanWardrobeCatalog::GetFolder(ItemPath);
+	TArray<FSoftObjectPath>* FolderItems = ItemsByFolder.Find(Folder);
+	if (FolderItems && FolderItems->Remove(ItemPath) > 0)
+	{
+		if (FolderItems->IsEmpty())
+		{
+			ItemsByFolder.Remove(Folder);
+		}
+		InvalidateQueries(ItemPath);
+		bDirty = true;
+	}
+}
+
+void FMetaHumanWardrobeCatalog::InvalidateQueries(const FSoftObjectPath& ItemPath)
+{
+	using namespace MetaHumanWardrobeCatalog;
+
+	const FString Folder = GetFolder(ItemPath);
+	for (auto It = QueryCache.CreateIterator(); It; ++It)
+	{
+		if (IsUnderRoot(Folder, GetQueryRoot(It.Key())))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+// ============================================================================
+// Asset Registry Events
+// ============================================================================
+
+bool FMetaHumanWardrobeCatalog::IsWardrobeItem(const FAssetData& AssetData)
+{
+	return AssetData.IsInstanceOf(UMetaHumanWardrobeItem::StaticClass());
+}
+
+void FMetaHumanWardrobeCatalog::HandleAssetAdded(const FAssetData& AssetData)
+{
+	// The initial scan reports every asset as added - HandleFilesLoaded picks them up in one query
+	if (FilesLoadedHandle.IsValid() || !IsWardrobeItem(AssetData))
+	{
+		return;
+	}
+	AddItem(AssetData.GetSoftObjectPath());
+}
+
+void FMetaHumanWardrobeCatalog::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	if (IsWardrobeItem(AssetData))
+	{
+		RemoveItem(AssetData.GetSoftObjectPath());
+	}
+}
+
+void FMetaHumanWardrobeCatalog::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (IsWardrobeItem(AssetData))
+	{
+		RemoveItem(FSoftObjectPath(OldObjectPath));
+		AddItem(AssetData.GetSoftObjectPath());
+	}
+}
+
+void FMetaHumanWardrobeCatalog::HandleFilesLoaded()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+	FilesLoadedHandle.Reset();
+
+	RebuildFromRegistry();
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+FString FMetaHumanWardrobeCatalog::GetCatalogFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MetaHumanGeneration"), TEXT("WardrobeCatalog.txt"));
+}
+
+bool FMetaHumanWardrobeCatalog::LoadFromFile()
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetCatalogFilePath()) || Lines.IsEmpty() || Lines[0] != MetaHumanWardrobeCatalog::FileHeader)
+	{
+		return false;
+	}
+
+	ItemsByFolder.Reset();
+	QueryCache.Reset();
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		const FSoftObjectPath ItemPath(Lines[LineIndex]);
+		if (ItemPath.IsValid())
+		{
+			AddItem(ItemPath);
+		}
+	}
+	bDirty = false;
+
+	UE_LOG(LogTemp, Log, TEXT("[WardrobeCatalog] Loaded %d wardrobe item(s) from %s"), Num(), *GetCatalogFilePath());
+	return true;
+}
+
+void FMetaHumanWardrobeCatalog::SaveIfDirty()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(MetaHumanWardrobeCatalog::FileHeader);
+	for (const TPair<FString, TArray<FSoftObjectPath>>& Folder : ItemsByFolder)
+	{
+		for (const FSoftObjectPath& ItemPath : Folder.Value)
+		{
+			Lines.Add(ItemPath.ToString());
+		}
+	}
+
+	const FString FilePath = GetCatalogFilePath();
+	if (!FMetaHumanAtomicFile::SaveStringArray(Lines, FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[WardrobeCatalog] Failed to save %s"), *FilePath);
+		return;
+	}
+	bDirty = false;
+}
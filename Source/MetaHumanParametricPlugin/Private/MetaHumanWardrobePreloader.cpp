@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Wardrobe Preloader - Implementation
+
+#include "MetaHumanWardrobePreloader.h"
+
+FMetaHumanWardrobePreloader::~FMetaHumanWardrobePreloader()
+{
+	Release();
+}
+
+void FMetaHumanWardrobePreloader::Preload(const TArray<FString>& ItemPaths)
+{
+	Release();
+
+	for (const FString& ItemPath : ItemPaths)
+	{
+		const FSoftObjectPath SoftPath(ItemPath);
+		if (SoftPath.IsValid())
+		{
+			RequestedPaths.AddUnique(SoftPath);
+		}
+	}
+
+	if (RequestedPaths.IsEmpty())
+	{
+		return;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	Handle = StreamableManager.RequestAsyncLoad(
+		RequestedPaths,
+		FStreamableDelegate(),
+		FStreamableManager::AsyncLoadHighPriority,
+		/*bManageActiveHandle*/ false,
+		/*bStartStalled*/ false,
+		TEXT("MetaHumanWardrobePreload"));
+
+	UE_LOG(LogTemp, Log, TEXT("[WardrobePreload] Requested %d wardrobe item(s)"), RequestedPaths.Num());
+}
+
+void FMetaHumanWardrobePreloader::Release()
+{
+	if (Handle.IsValid())
+	{
+		Handle->ReleaseHandle();
+		Handle.Reset();
+	}
+	RequestedPaths.Reset();
+}
+
+bool FMetaHumanWardrobePreloader::IsComplete() const
+{
+	return Handle.IsValid() && (Handle->HasLoadCompleted() || Handle->WasCanceled());
+}
+
+int32 FMetaHumanWardrobePreloader::GetNumLoaded() const
+{
+	int32 NumLoaded = 0;
+	for (const FSoftObjectPath& SoftPath : RequestedPaths)
+	{
+		if (SoftPath.ResolveObject())
+		{
+			++NumLoaded;
+		}
+	}
+	return NumLoaded;
+}
+
+double FMetaHumanWardrobePreloader::GetLoadSeconds() const
+{
+	return Handle.IsValid() ? FPlatformTime::Seconds() - StartTime : 0.0;
+}
+
+void FMetaHumanWardrobePreloader::LogMissingItems() const
+{
+	for (const FSoftObjectPath& SoftPath : RequestedPaths)
+	{
+		if (!SoftPath.ResolveObject())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[WardrobePreload] Failed to load %s"), *SoftPath.ToString());
+		}
+	}
+}
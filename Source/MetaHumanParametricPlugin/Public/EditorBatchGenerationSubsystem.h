@@ -5,10 +5,15 @@
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
 #include "MetaHumanParametricGenerator.h"
+#include "MetaHumanBatchPlanner.h"
+#include "MetaHumanBatchMetrics.h"
+#include "MetaHumanBatchJobQueue.h"
 #include "EditorBatchGenerationSubsystem.generated.h"
 
 // Forward declarations
 class UMetaHumanCharacter;
+class UMetaHumanCharacterEditorSubsystem;
+class FMetaHumanWardrobePreloader;
 
 /**
  * Generation State Machine
@@ -18,10 +23,151 @@ enum class EBatchGenState : uint8
 {
 	Idle UMETA(DisplayName = "Idle"),
 	Preparing UMETA(DisplayName = "Preparing Character"),
-	WaitingForRig UMETA(DisplayName = "Waiting for AutoRig"),
+	WaitingForRig UMETA(DisplayName = "Waiting for AutoRig/Textures"),
 	Assembling UMETA(DisplayName = "Assembling Character"),
+	Saving UMETA(DisplayName = "Writing Assembled Packages"),
 	Complete UMETA(DisplayName = "Complete"),
-	Error UMETA(DisplayName = "Error")
+	Error UMETA(DisplayName = "Error"),
+	Backoff UMETA(DisplayName = "Waiting to Retry")
+};
+
+/**
+ * Progress of an async operation a job waits on in the WaitingForRig state
+ */
+UENUM(BlueprintType)
+enum class EBatchGenTaskState : uint8
+{
+	NotStarted UMETA(DisplayName = "Not Started"),
+	Running UMETA(DisplayName = "Running"),
+	Done UMETA(DisplayName = "Done"),
+	Failed UMETA(DisplayName = "Failed")
+};
+
+/**
+ * A single character moving through the generation state machine.
+ * The subsystem keeps a table of these so that several characters can be in flight at once.
+ */
+USTRUCT(BlueprintType)
+struct FBatchGenerationJob
+{
+	GENERATED_BODY()
+
+	/** Id assigned by the scheduler when the job is started */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 JobId = INDEX_NONE;
+
+	/** Current state of this job */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	EBatchGenState State = EBatchGenState::Idle;
+
+	/** Manifest entry this job expands into a character */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FMetaHumanBatchManifestEntry ManifestEntry;
+
+	/** Name of the character generated by this job */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FString CharacterName;
+
+	/** Last error message reported by this job */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FString LastErrorMessage;
+
+	/** Classification of the last failure */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	EMetaHumanGenerationFailure FailureReason = EMetaHumanGenerationFailure::None;
+
+	/** Number of retries already spent on this job */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 RetryCount = 0;
+
+	/** AutoRig of the character (or the rig cache lookup), started at the end of preparation */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	EBatchGenTaskState RigTask = EBatchGenTaskState::NotStarted;
+
+	/** High-resolution texture fetch, started as soon as the skin is committed and run alongside AutoRig */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	EBatchGenTaskState TextureTask = EBatchGenTaskState::NotStarted;
+
+	/** Retries already spent on the texture fetch (separate from the job's RetryCount) */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 TextureRetryCount = 0;
+
+	/** Wardrobe variant assembled next (0 = the entry's own wardrobe) */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 VariantIndex = 0;
+
+	/** Reference to the character being generated */
+	TWeakObjectPtr<UMetaHumanCharacter> Character;
+
+	/** Sessions of the assemblies whose packages are still being written, marked Completed in the Saving state */
+	TArray<FString> PendingSaveSessions;
+
+	/** Preparation in progress, advanced a few steps per tick while the job is Preparing */
+	UPROPERTY()
+	FMetaHumanPrepareContext PrepareContext;
+
+	/** Remaining loop delay before this job's slot is handed to the next character */
+	float LoopDelayTimer = 0.0f;
+
+	/** Set on every transition so the new state's entry logic runs once */
+	bool bShouldProcessState = true;
+
+	/** Set by OnRiggingStateChanged so the job is re-evaluated on the next frame */
+	bool bRigStateChanged = false;
+
+	/** High-resolution textures were served by the texture cache, no download was started */
+	bool bTexturesFromCache = false;
+
+	/** FPlatformTime::Seconds() when the job was started */
+	double JobStartTime = 0.0;
+
+	/** FPlatformTime::Seconds() when the current stage was entered */
+	double StageStartTime = 0.0;
+
+	/** FPlatformTime::Seconds() after which the current wait is treated as a timeout */
+	double StageDeadline = 0.0;
+
+	/** FPlatformTime::Seconds() when the rig finished, to measure how long textures held the job up */
+	double RigDoneTime = 0.0;
+
+	/** Texture fetch timing: start, deadline of the running request, and when a failed request is sent again (0 = none scheduled) */
+	double TextureStartTime = 0.0;
+	double TextureDeadline = 0.0;
+	double TextureRetryTime = 0.0;
+
+	/** Remaining time in the Backoff state before the retry starts */
+	float BackoffRemaining = 0.0f;
+};
+
+/**
+ * A job that failed and ran out of retries
+ */
+USTRUCT(BlueprintType)
+struct FBatchGenerationDeadLetter
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 JobId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FMetaHumanBatchManifestEntry ManifestEntry;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FString CharacterName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	EMetaHumanGenerationFailure FailureReason = EMetaHumanGenerationFailure::None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FString ErrorMessage;
+
+	/** Total attempts, including the first one */
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	int32 Attempts = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MetaHuman|BatchGen")
+	FDateTime Timestamp;
 };
 
 /**
@@ -30,7 +176,33 @@ enum class EBatchGenState : uint8
  * This subsystem runs in the editor and manages automatic MetaHuman character generation
  * with randomized parameters. Unlike actors, editor subsystems work without running the game.
  *
- * Uses FTSTicker (editor timer) to periodically check AutoRig status and advance the state machine.
+ * Uses FTSTicker (editor timer) to advance the state machine every frame. Rig completion is
+ * event driven (OnRiggingStateChanged) and texture completion is checked with a typed query,
+ * so a job moves on as soon as its character is ready; polling every CheckInterval is only
+ * kept as a watchdog in case an event is missed.
+ * Every character is tracked as its own job with its own state machine; the scheduler in
+ * TickStateMachine keeps up to MaxConcurrentJobs characters in flight, so the network-bound
+ * AutoRig wait of one character overlaps with the preparation and assembly of others.
+ *
+ * The high-resolution texture fetch is a stage of its own: it starts as soon as the skin is
+ * committed, runs alongside AutoRig with its own deadline and retries, and assembly starts
+ * once both are done.
+ *
+ * A failed job is retried with exponential backoff; waits on AutoRig and textures have
+ * deadlines. Jobs that run out of retries go to a dead-letter list (and file) and free
+ * their slot, so one bad character never stalls the loop.
+ *
+ * Characters are drawn from a seeded manifest (see UMetaHumanBatchPlanner), so any batch
+ * can be reproduced or sharded by replaying its seed or manifest file.
+ *
+ * Assembled packages are written by the engine's async file writer. A job waits for its writes
+ * in the Saving state without holding a slot, so the disk I/O overlaps with the next character's
+ * preparation; its sessions are marked Completed once the writes have finished. At most
+ * MaxConcurrentJobs jobs wait like this, further ones hold a slot until the writer catches up.
+ *
+ * A finished job is torn down before its slot is reused: its character is removed from
+ * editing, its saved packages are released and garbage is collected on a schedule, so
+ * memory stays flat over long runs.
  */
 UCLASS()
 class METAHUMANPARAMETRICPLUGIN_API UEditorBatchGenerationSubsystem : public UEditorSubsystem
@@ -53,8 +225,9 @@ public:
 	 * @param bLoopMode - If true, continuously generate characters
 	 * @param OutputPath - Where to save generated characters
 	 * @param QualityLevel - Quality level for character assembly
-	 * @param CheckInterval - How often to check AutoRig status (seconds)
+	 * @param CheckInterval - Watchdog interval for re-checking AutoRig status if no event arrives (seconds)
 	 * @param LoopDelay - Delay between characters in loop mode (seconds)
+	 * @param MaxConcurrentJobs - Maximum number of characters in flight at the same time
 	 */
 	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
 	void StartBatchGeneration(
@@ -62,7 +235,72 @@ public:
 		FString OutputPath = TEXT("/Game/MetaHumans"),
 		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
 		float CheckInterval = 2.0f,
-		float LoopDelay = 5.0f);
+		float LoopDelay = 5.0f,
+		int32 MaxConcurrentJobs = 4);
+
+	/**
+	 * Generate every entry of a planned manifest, then stop
+	 * @param Manifest - Entries to generate, see UMetaHumanBatchPlanner::PlanBatch
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void StartBatchGenerationFromManifest(
+		const FMetaHumanBatchManifest& Manifest,
+		FString OutputPath = TEXT("/Game/MetaHumans"),
+		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
+		float CheckInterval = 2.0f,
+		int32 MaxConcurrentJobs = 4);
+
+	/**
+	 * Plan Count characters from BatchSeed and generate them
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void StartSeededBatchGeneration(
+		int32 BatchSeed,
+		int32 Count,
+		FString OutputPath = TEXT("/Game/MetaHumans"),
+		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
+		float CheckInterval = 2.0f,
+		int32 MaxConcurrentJobs = 4);
+
+	/**
+	 * Load a manifest written by UMetaHumanBatchPlanner::WriteManifestToFile and generate it
+	 * @return false if the manifest could not be loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	bool StartBatchGenerationFromManifestFile(
+		const FString& ManifestFilePath,
+		FString OutputPath = TEXT("/Game/MetaHumans"),
+		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
+		float CheckInterval = 2.0f,
+		int32 MaxConcurrentJobs = 4);
+
+	/**
+	 * Generate a manifest together with other editor or commandlet processes
+	 * Entries are claimed through the on-disk queue of the batch (see FMetaHumanBatchJobQueue),
+	 * so any number of workers can join, leave or crash without losing or duplicating characters.
+	 * The first worker publishes the manifest; workers joining later use the published one.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void StartSharedBatchGeneration(
+		const FMetaHumanBatchManifest& Manifest,
+		FString OutputPath = TEXT("/Game/MetaHumans"),
+		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
+		float CheckInterval = 2.0f,
+		int32 MaxConcurrentJobs = 4);
+
+	/**
+	 * Configure the leases of shared batches (seconds)
+	 * @param LeaseDuration - How long an entry stays reserved without renewal; must cover the longest blocking step (assembly)
+	 * @param RenewInterval - How often the leases of running jobs are renewed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetLeaseTiming(float LeaseDuration, float RenewInterval);
+
+	/**
+	 * Seed of the current (or last) batch - replaying it reproduces the same characters
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MetaHuman|BatchGen")
+	int32 GetBatchSeed() const { return ActiveManifest.BatchSeed; }
 
 	/**
 	 * Stop the current batch generation process
@@ -80,13 +318,144 @@ public:
 	 * Check if batch generation is currently running
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MetaHuman|BatchGen")
-	bool IsRunning() const { return CurrentState != EBatchGenState::Idle && CurrentState != EBatchGenState::Error; }
+	bool IsRunning() const { return bBatchRunning; }
 
 	/**
 	 * Get status information
+	 * OutState and OutCharacterName describe the oldest job that is still in flight,
+	 * OutMetrics holds the per-stage latencies and throughput of the current batch
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void GetStatusInfo(EBatchGenState& OutState, FString& OutCharacterName, int32& OutGeneratedCount, FMetaHumanBatchMetricsSnapshot& OutMetrics) const;
+
+	/**
+	 * Get a snapshot of every job currently held by the scheduler
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void GetActiveJobs(TArray<FBatchGenerationJob>& OutJobs) const { OutJobs = Jobs; }
+
+	/**
+	 * Get the jobs of the current batch that failed after all retries
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void GetDeadLetters(TArray<FBatchGenerationDeadLetter>& OutDeadLetters) const { OutDeadLetters = DeadLetters; }
+
+	/**
+	 * Configure retries of failed jobs
+	 * @param MaxRetries - Retries per job after the first attempt (0 disables retrying)
+	 * @param BaseDelay - Delay before the first retry (seconds), doubled on every further retry
+	 * @param MaxDelay - Upper bound of the retry delay (seconds)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetRetryPolicy(int32 MaxRetries, float BaseDelay = 10.0f, float MaxDelay = 120.0f);
+
+	/**
+	 * Configure how long a job may wait for AutoRig and for the texture download (seconds)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
-	void GetStatusInfo(EBatchGenState& OutState, FString& OutCharacterName, int32& OutGeneratedCount) const;
+	void SetStageTimeouts(float RigTimeout, float TextureTimeout);
+
+	/**
+	 * Change the number of characters kept in flight; takes effect on the next scheduler tick
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetMaxConcurrentJobs(int32 MaxConcurrentJobs) { MaxConcurrentJobsConfig = FMath::Max(1, MaxConcurrentJobs); }
+
+	/**
+	 * Game thread time all Preparing jobs may spend per tick (milliseconds)
+	 * At least one preparation step runs per tick, so a single slow step can still exceed it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetPrepareBudget(float BudgetMs) { PrepareBudgetMsConfig = FMath::Max(0.0f, BudgetMs); }
+
+	/**
+	 * Number of characters assembled from each AutoRig result (1 = one character per entry)
+	 * The extra variants keep the entry's face and body and only re-draw hair, clothing and
+	 * colors (see UMetaHumanBatchPlanner::ExpandWardrobeVariant), so K characters cost one AutoRig.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetVariantsPerRig(int32 VariantsPerRig) { VariantsPerRigConfig = FMath::Max(1, VariantsPerRig); }
+
+	/**
+	 * Reuse face DNA from the local rig cache (see FMetaHumanRigCache) instead of calling AutoRig
+	 * for faces that were rigged before; rigs returned by AutoRig are added to the cache
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetRigCacheEnabled(bool bEnabled) { bUseRigCacheConfig = bEnabled; }
+
+	/**
+	 * Build the Preview collection after each character's wardrobe is added (and after each variant's)
+	 * Without clothing only the viewport uses it; turn it off for unattended batches - assembly does the full
+	 * build anyway. Wardrobes with clothing are always built, the preview build initializes their Chaos cloth.
+	 * The time it costs is reported as the Prepare.PreviewBuild stage.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetPreviewBuildEnabled(bool bEnabled) { bBuildPreviewConfig = bEnabled; }
+
+	/**
+	 * Load every hair and clothing item the planner can draw asynchronously when a batch starts
+	 * (see FMetaHumanWardrobePreloader). Jobs wait for it before their wardrobe steps instead of
+	 * loading items synchronously. Takes effect on the next batch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetWardrobePreloadEnabled(bool bEnabled) { bPreloadWardrobeConfig = bEnabled; }
+
+	/**
+	 * Create characters as copies of an initialized prototype (see UMetaHumanParametricGenerator::CreateCharacterFromPrototype)
+	 * Prepare.CreateCharacter reports the per-character cost of either mode, Prepare.PrototypeInit the one-off initialization.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetCharacterPrototypeEnabled(bool bEnabled) { bUseCharacterPrototypeConfig = bEnabled; }
+
+	/**
+	 * High-resolution texture download of the batch's characters
+	 * FromQuality follows UMetaHumanParametricGenerator::GetTextureResolutionForQuality (no download for Medium and Low);
+	 * any other value overrides it for every quality level. Takes effect on the next batch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetTextureResolution(EMetaHumanTextureResolution Resolution) { TextureResolutionConfig = Resolution; }
+
+	/**
+	 * Quality levels every rigged character is assembled at in addition to the batch's own
+	 * The rig and textures are reused, so each extra level only costs assembly time. With extra
+	 * levels each one is built under <OutputPath>/<Level>. Takes effect on the next batch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetExtraQualityLevels(const TArray<EMetaHumanQualityLevel>& QualityLevels) { ExtraQualityLevelsConfig = QualityLevels; }
+
+	/**
+	 * Serve high-resolution textures seen before from the local texture cache (see FMetaHumanTextureCache)
+	 * @param MaxSizeMB - Least recently used entries are evicted once the cache grows past this
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetTextureCache(bool bEnabled, int32 MaxSizeMB = 8192) { bUseTextureCacheConfig = bEnabled; TextureCacheMaxMBConfig = FMath::Max(0, MaxSizeMB); }
+
+	/**
+	 * Run a garbage collection after every JobsPerCollection finished jobs (0 = leave it to the engine)
+	 * Finished characters are always removed from editing and their saved packages released; the
+	 * collection is what frees them. It blocks the game thread and with it every job in flight, so it
+	 * is spread over several jobs. The memory change between collections is reported with the metrics.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetGarbageCollectionInterval(int32 JobsPerCollection) { GCIntervalJobsConfig = FMath::Max(0, JobsPerCollection); }
+
+	/**
+	 * Write assembled packages in the background (see FMetaHumanAssemblyOptions::bAsyncSave)
+	 * When off, every assembly waits for its files before the job completes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetAsyncSaveEnabled(bool bEnabled) { bAsyncSaveConfig = bEnabled; }
+
+	/**
+	 * Name of this worker in shared batches, its shared assets go to <OutputPath>/Common_<Instance>
+	 * Empty = the host name. Keep it the same across restarts so the folder (and its common asset
+	 * manifest entries) is reused; processes that run at the same time need different names.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchGen")
+	void SetWorkerInstance(const FString& InstanceName) { WorkerInstanceConfig = InstanceName; }
+
+	/** Display string for a single job state */
+	static FString GetStateDisplayString(EBatchGenState State);
 
 private:
 	// ============================================================================
@@ -94,64 +463,254 @@ private:
 	// ============================================================================
 
 	/**
-	 * Ticker callback - called periodically to update state machine
+	 * Ticker callback - called every frame to update state machine
 	 * This is how we "tick" in the editor without running the game
 	 */
 	bool TickStateMachine(float DeltaTime);
 
-	void TransitionToState(EBatchGenState NewState);
+	/** MetaHuman editor subsystem callback - flags the job owning the character for processing */
+	void HandleRiggingStateChanged(TNotNull<const UMetaHumanCharacter*> InCharacter, EMetaHumanCharacterRigState NewState);
+
+	/** Subscribe to / unsubscribe from the MetaHuman editor subsystem events */
+	void BindCompletionEvents();
+	void UnbindCompletionEvents();
+
+	/** Whether a job waiting for its rig needs to run its handler this frame */
+	bool ShouldProcessWaitingJob(const FBatchGenerationJob& Job, bool bStateEntered, bool bWatchdogPoll) const;
+
+	void TransitionToState(FBatchGenerationJob& Job, EBatchGenState NewState);
+
+	/** Run the handler for the job's current state */
+	void ProcessJob(FBatchGenerationJob& Job, float DeltaTime, bool bWatchdogPoll);
+
+	/** Fill free slots with new jobs and drop the ones that are finished */
+	void ScheduleJobs();
+
+	/** Record the duration of the job's current stage and restart the stage clock */
+	void EndStage(FBatchGenerationJob& Job, FName Stage, bool bSuccess);
+
+	/** Write the metrics snapshot of the current batch under Saved/MetaHumanGeneration/Metrics */
+	void DumpMetrics() const;
+
+	/** Whether the character limit of the current batch still allows starting a job */
+	bool CanStartNewJob() const;
+
+	/**
+	 * Manifest entry for the next job - claimed from the queue for shared batches, otherwise
+	 * planned entries first, then derived from the batch seed
+	 * @return false if no entry can be started right now
+	 */
+	bool TryGetNextManifestEntry(FMetaHumanBatchManifestEntry& OutEntry);
+
+	/** Renew the queue lease of a job; abandons the job if another worker took the entry over */
+	bool RenewJobLease(FBatchGenerationJob& Job);
+
+	/** Tag of the per-batch output files - includes the worker id for shared batches, which many processes write */
+	FString GetBatchFileTag() const;
+
+	/** Store the configuration, reset counters and start the scheduler */
+	void BeginBatch(
+		bool bLoopMode,
+		const FString& OutputPath,
+		EMetaHumanQualityLevel QualityLevel,
+		float CheckInterval,
+		float LoopDelay,
+		int32 MaxConcurrentJobs);
 
 	// State handlers
-	void HandleIdleState();
-	void HandlePreparingState();
-	void HandleWaitingForRigState();
-	void HandleAssemblingState();
-	void HandleCompleteState();
-	void HandleErrorState();
+	void HandlePreparingState(FBatchGenerationJob& Job, bool bStateEntered);
+	void HandleWaitingForRigState(FBatchGenerationJob& Job);
+	void HandleAssemblingState(FBatchGenerationJob& Job);
+	void HandleSavingState(FBatchGenerationJob& Job);
+	void HandleCompleteState(FBatchGenerationJob& Job, bool bStateEntered, float DeltaTime);
+	void HandleErrorState(FBatchGenerationJob& Job);
+	void HandleBackoffState(FBatchGenerationJob& Job, float DeltaTime);
 
-	// ============================================================================
-	// Random Parameter Generation
-	// ============================================================================
+	/**
+	 * Start the texture fetch of a job - from the texture cache, otherwise as a download
+	 * @param bFinalAttempt - Preparation is over; if nothing can be requested the job assembles without high-resolution textures
+	 */
+	void StartTextureFetch(FBatchGenerationJob& Job, UMetaHumanCharacter* Character, bool bFinalAttempt);
+
+	/** Advance a running texture fetch: completion, timeout and its own retries */
+	void UpdateTextureFetch(FBatchGenerationJob& Job, UMetaHumanCharacterEditorSubsystem* EditorSubsystem);
+
+	/** Record the preload stage once the batch's wardrobe items have streamed in */
+	void UpdateWardrobePreload();
+
+	/** No preload requested, or all of it has loaded */
+	bool IsWardrobePreloadComplete() const;
 
-	void GenerateRandomCharacterConfigs(
-		FMetaHumanBodyParametricConfig& OutBodyConfig,
-		FMetaHumanAppearanceConfig& OutAppearanceConfig,
-		FString& OutCharacterName);
+	/** Let the preloaded wardrobe items be garbage collected again */
+	void ReleaseWardrobePreload();
+
+	/** End-of-job teardown: stop editing the job's character and release its packages to the next garbage collection, unsaved ones included */
+	void ReleaseJobCharacter(FBatchGenerationJob& Job);
+
+	/**
+	 * Collect garbage once GCIntervalJobsConfig torn down jobs have left the job table, and record the memory change since the last collection
+	 * @param bForce - Collect for any number of pending jobs (end of batch)
+	 */
+	void CollectGarbageIfDue(bool bForce);
+
+	/** Move on to the job's next wardrobe variant, or complete the job after the last one */
+	void FinishAssemblyVariant(FBatchGenerationJob& Job);
+
+	/**
+	 * Completion barrier of an async save: wait for the outstanding writes, mark the job's sessions Completed and complete it
+	 * The writer only reports writes of the whole process, so this also waits for writes of other jobs.
+	 */
+	void FinishSaving(FBatchGenerationJob& Job);
+
+	/** Record the job's total time, mark its queue entry done and move it to Complete */
+	void CompleteJob(FBatchGenerationJob& Job);
+
+	/**
+	 * Jobs counted against MaxConcurrentJobs
+	 * A job in the Saving state only waits for the disk and does not hold a slot, unless more than
+	 * MaxConcurrentJobs of them are waiting - then the writer is behind and new jobs would only add to it.
+	 */
+	int32 GetNumJobsInSlots() const;
+
+	/** Record the failure on the job and move it to the Error state */
+	void FailJob(FBatchGenerationJob& Job, EMetaHumanGenerationFailure Reason, const FString& Message);
+
+	/** Whether a failure of this kind is worth retrying (config errors are deterministic) */
+	static bool IsRetryableFailure(EMetaHumanGenerationFailure Reason);
+
+	/** Exponential backoff with +-25% jitter for the given retry number */
+	float GetRetryDelay(int32 RetryCount) const;
+
+	/** Add the job to the dead-letter list and append it to the dead-letter file */
+	void AddDeadLetter(const FBatchGenerationJob& Job);
 
 	// ============================================================================
 	// Internal State
 	// ============================================================================
 
-	/** Current generation state */
-	EBatchGenState CurrentState = EBatchGenState::Idle;
+	/** Whether a batch is currently running */
+	bool bBatchRunning = false;
 
-	/** Reference to the character being generated */
-	TWeakObjectPtr<UMetaHumanCharacter> GeneratedCharacter;
+	/** Job table - one entry per character in flight (a UPROPERTY so the prepare contexts stay referenced) */
+	UPROPERTY()
+	TArray<FBatchGenerationJob> Jobs;
 
-	/** Current character name */
-	FString CurrentCharacterName;
+	/** Index of the job processed first on the next tick, rotated so no job always gets the budget first */
+	int32 FirstJobToProcess = 0;
 
-	/** Last error message */
-	FString LastErrorMessage;
+	/** Id handed to the next job */
+	int32 NextJobId = 0;
+
+	/** Number of jobs started in the current batch */
+	int32 StartedCount = 0;
 
 	/** Number of characters generated */
 	int32 GeneratedCount = 0;
 
+	/** Number of jobs that ended in the Error state */
+	int32 FailedCount = 0;
+
 	/** Configuration */
 	bool bLoopGenerationEnabled = false;
 	FString OutputPathConfig;
 	EMetaHumanQualityLevel QualityLevelConfig = EMetaHumanQualityLevel::Cinematic;
+	TArray<EMetaHumanQualityLevel> ExtraQualityLevelsConfig;
 	float CheckIntervalConfig = 2.0f;
 	float LoopDelayConfig = 5.0f;
+	int32 MaxConcurrentJobsConfig = 4;
 
-	/** Loop delay timer */
-	float LoopDelayTimer = 0.0f;
+	/** Total number of characters to start in this batch (0 = unlimited) */
+	int32 CharacterLimitConfig = 0;
+
+	/** Wardrobe variants assembled per rigged character */
+	int32 VariantsPerRigConfig = 1;
+
+	/** Look faces up in the rig cache before starting AutoRig */
+	bool bUseRigCacheConfig = true;
+
+	/** Run the viewport preview build during preparation */
+	bool bBuildPreviewConfig = true;
+
+	/** Copy new characters from an initialized prototype */
+	bool bUseCharacterPrototypeConfig = true;
+
+	/** Stream the wardrobe catalog in when a batch starts and keep it resident until the batch ends */
+	bool bPreloadWardrobeConfig = true;
+	TSharedPtr<FMetaHumanWardrobePreloader> WardrobePreloader;
+	bool bWardrobePreloadRecorded = false;
+
+	/** Garbage collection between jobs, see SetGarbageCollectionInterval */
+	int32 GCIntervalJobsConfig = 8;
+	int32 JobsSinceCollection = 0;
+
+	/** Used physical memory after the last collection (or at batch start) */
+	uint64 LastCollectionUsedPhysical = 0;
+
+	/** Write assembled packages in the background, see SetAsyncSaveEnabled */
+	bool bAsyncSaveConfig = true;
+
+	/** Common folder name of this worker in shared batches, see SetWorkerInstance */
+	FString WorkerInstanceConfig;
+
+	/** Levels assembled from each rig in the running batch - QualityLevelConfig first, then the extra levels */
+	TArray<EMetaHumanQualityLevel> BatchQualityLevels;
+
+	/** Requested texture download, and what it resolved to for the running batch (largest of its levels) */
+	EMetaHumanTextureResolution TextureResolutionConfig = EMetaHumanTextureResolution::FromQuality;
+	EMetaHumanTextureResolution BatchTextureResolution = EMetaHumanTextureResolution::Res2k;
+
+	/** Look textures up in the texture cache before downloading them */
+	bool bUseTextureCacheConfig = true;
+	int32 TextureCacheMaxMBConfig = 8192;
+
+	/** Seed and planned entries of the current batch (entries are empty for open-ended batches) */
+	FMetaHumanBatchManifest ActiveManifest;
+
+	/** On-disk queue shared with other processes (shared batches only) */
+	TSharedPtr<FMetaHumanBatchJobQueue> JobQueue;
+
+	/** Queue polling and lease renewal */
+	double NextQueueClaimTime = 0.0;
+	bool bQueueComplete = false;
+	float LeaseDurationConfig = 300.0f;
+	float LeaseRenewIntervalConfig = 30.0f;
+	float LeaseRenewTimer = 0.0f;
+
+	/** Retry policy */
+	int32 MaxRetriesConfig = 2;
+	float RetryBaseDelayConfig = 10.0f;
+	float RetryMaxDelayConfig = 120.0f;
+
+	/** Per-tick game thread budget of the Preparing state */
+	float PrepareBudgetMsConfig = 8.0f;
+	double PrepareBudgetDeadline = 0.0;
+	bool bPrepareStepRunThisTick = false;
+
+	/** Stage deadlines (seconds) */
+	float RigTimeoutConfig = 300.0f;
+	float TextureTimeoutConfig = 300.0f;
+
+	/** A Saving job blocks on the writer after this long, so a steady stream of writes from other jobs cannot hold it back forever */
+	float SaveFlushTimeoutConfig = 60.0f;
+
+	/** Jobs of the current batch that failed after all retries */
+	TArray<FBatchGenerationDeadLetter> DeadLetters;
+
+	/** Stage timings and throughput of the current batch */
+	FMetaHumanBatchMetrics Metrics;
+
+	/** How often the metrics file is rewritten while a batch runs (seconds) */
+	float MetricsDumpIntervalConfig = 30.0f;
+	float MetricsDumpTimer = 0.0f;
 
 	/** Ticker handle for the state machine update */
 	FTSTicker::FDelegateHandle TickerHandle;
 
-	/** Flag to indicate state should be processed */
-	bool bShouldProcessState = true;
+	/** Time since the last watchdog poll */
+	float WatchdogTimer = 0.0f;
+
+	/** Handle for UMetaHumanCharacterEditorSubsystem::OnRiggingStateChanged */
+	FDelegateHandle RiggingStateChangedHandle;
 
 	bool bAutoStartGeneration = false;
 };
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Appearance Transaction
+//
+// Stages skin, eyes and head model settings and pushes them to the character
+// editor subsystem together. Every Apply/Commit pair regenerates textures or
+// materials (the skin pair synthesizes face textures on the CPU), so Commit
+// only issues the pairs whose settings differ from what the character already
+// has - a re-run of the same entry changes nothing at all.
+//
+// This is not a single regeneration: the subsystem has no way to defer its
+// updates across groups, so each changed group still regenerates once. A
+// freshly randomized character changes all three and costs what three
+// separate Apply/Commit pairs cost.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetaHumanCharacter.h"
+
+/**
+ * One coalesced appearance update of a character
+ * Game thread only (uses the MetaHuman character editor subsystem).
+ *
+ *   FMetaHumanAppearanceTransaction Transaction(Character);
+ *   Transaction.StageSkin(Config.SkinSettings);
+ *   Transaction.StageEyes(Config.EyesSettings);
+ *   Transaction.Commit();
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanAppearanceTransaction
+{
+public:
+	explicit FMetaHumanAppearanceTransaction(UMetaHumanCharacter* InCharacter);
+
+	/** Stage settings; staging the same group again replaces the earlier value */
+	void StageSkin(const FMetaHumanCharacterSkinSettings& SkinSettings);
+	void StageEyes(const FMetaHumanCharacterEyesSettings& EyesSettings);
+	void StageHeadModel(const FMetaHumanCharacterHeadModelSettings& HeadModelSettings);
+
+	/**
+	 * Apply and commit every staged group that differs from the character's current settings
+	 * The staged settings are cleared either way.
+	 * @return false if there is no character or editor subsystem
+	 */
+	bool Commit();
+
+	/** Number of groups the last Commit pushed to the character (0-3) */
+	int32 GetNumCommitted() const { return NumCommitted; }
+
+	/** Number of staged groups the last Commit skipped because nothing changed */
+	int32 GetNumSkipped() const { return NumSkipped; }
+
+private:
+	TWeakObjectPtr<UMetaHumanCharacter> Character;
+
+	TOptional<FMetaHumanCharacterSkinSettings> StagedSkin;
+	TOptional<FMetaHumanCharacterEyesSettings> StagedEyes;
+	TOptional<FMetaHumanCharacterHeadModelSettings> StagedHeadModel;
+
+	int32 NumCommitted = 0;
+	int32 NumSkipped = 0;
+};
@@ -52,6 +52,29 @@ struct FMetaHumanAssemblyBuildParameters
 	}
 };
 
+/**
+ * Counters of the pipeline cache used by GetDefaultPipelineForQuality, since process start
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanPipelineCacheStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pipeline Cache")
+	int32 Hits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pipeline Cache")
+	int32 Misses = 0;
+
+	/** Pipeline class loading, done on misses only - what a hit skips */
+	UPROPERTY(BlueprintReadOnly, Category = "Pipeline Cache")
+	float ClassLoadSeconds = 0.0f;
+
+	/** Creating the instances, hits and misses alike */
+	UPROPERTY(BlueprintReadOnly, Category = "Pipeline Cache")
+	float InstantiateSeconds = 0.0f;
+};
+
 /**
  * MetaHuman Assembly Pipeline Manager
  *
@@ -83,16 +106,27 @@ public:
 
 	/**
 	 * Get the default pipeline for a given quality level
+	 * The pipeline class is resolved once per (quality level, UEFN/legacy) and kept loaded, so garbage
+	 * collections between characters do not unload it and its default assets. Every call returns a new
+	 * instance, so each character owns its pipeline. The class is resolved again when the project
+	 * settings point the quality level at another class.
 	 *
 	 * @param QualityLevel - The quality level (Cinematic, High, Medium, Low)
 	 * @param bUseUEFNPipeline - If true, returns UEFN pipeline instead of legacy
-	 * @return The pipeline class for the given quality level
+	 * @return The pipeline for the given quality level
 	 */
 	UFUNCTION(BlueprintCallable, Category = "MetaHuman|Assembly")
 	static UMetaHumanCollectionPipeline* GetDefaultPipelineForQuality(
 		EMetaHumanQualityLevel QualityLevel,
 		bool bUseUEFNPipeline = false);
 
+	/** Drop the cached pipeline classes; the next GetDefaultPipelineForQuality call loads them again */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|Assembly")
+	static void ResetPipelineCache();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MetaHuman|Assembly")
+	static FMetaHumanPipelineCacheStats GetPipelineCacheStats();
+
 	/**
 	 * Check if a character can be built with the current settings
 	 *
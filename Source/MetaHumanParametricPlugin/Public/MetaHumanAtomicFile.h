@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Atomic File
+//
+// Every file the generator shares between processes or reads back later
+// (sessions, caches, manifests, the batch queue, metrics) is written to a
+// per-process temp file next to the target and then renamed into place, so a
+// killed process or a concurrent reader never sees a truncated file:
+//
+//   <File>.<ProcessId>.tmp  ->  <File>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+/**
+ * Write-aside-then-rename helpers
+ * Thread safe as long as two callers do not write the same file.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanAtomicFile
+{
+public:
+	/**
+	 * Let WriteTempFile fill the temp file, then move it over FilePath
+	 * The temp file is deleted when either step fails.
+	 * @param WriteTempFile - Writes the complete content to the path it is given, false on failure
+	 * @param bFailIfExists - Leave an existing FilePath alone and fail instead; the rename is then the
+	 *                        only step that decides between two writers (exclusive creation)
+	 */
+	static bool Write(const FString& FilePath, TFunctionRef<bool(const FString& TempFilePath)> WriteTempFile, bool bFailIfExists = false);
+
+	static bool SaveString(const FString& Content, const FString& FilePath, bool bFailIfExists = false);
+	static bool SaveStringArray(const TArray<FString>& Lines, const FString& FilePath);
+	static bool SaveArray(const TArray<uint8>& Data, const FString& FilePath);
+
+	/** <FilePath>.<ProcessId>.tmp */
+	static FString GetTempFilePath(const FString& FilePath);
+};
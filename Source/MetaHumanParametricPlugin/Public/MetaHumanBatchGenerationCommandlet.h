@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Generation Commandlet
+//
+// Headless entry point for farm nodes. Runs the same prepare/rig/assemble
+// state machine as UEditorBatchGenerationSubsystem, but without the level
+// editor, toolbar menus or Slate notifications, and exits when the batch is done.
+//
+// Usage:
+//   UnrealEditor-Cmd.exe Project.uproject -run=MetaHumanBatchGeneration
+//       [-Manifest=<file.jsonl>] [-Count=<n>] [-Seed=<n>]
+//       [-OutputPath=/Game/MetaHumans] [-Quality=Cinematic[,Low]] [-MaxConcurrent=4]
+//       [-VariantsPerRig=1] [-NoRigCache] [-NoTextureCache] [-TextureResolution=Res2k] [-PreviewBuild]
+//       [-NoWardrobePreload] [-NoPrototype] [-GCInterval=8] [-NoAsyncSave] [-Shared] [-Instance=<name>]
+//       -nullrhi -unattended -nosplash
+//
+// With -Shared any number of processes can run the same -Seed/-Manifest;
+// they split the entries through FMetaHumanBatchJobQueue. Each worker writes
+// the shared assets to its own <OutputPath>/Common_<Instance> folder; the
+// instance defaults to the host name, so give processes that share a host
+// their own -Instance and reuse it when a worker is restarted.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "MetaHumanBatchGenerationCommandlet.generated.h"
+
+UCLASS()
+class UMetaHumanBatchGenerationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMetaHumanBatchGenerationCommandlet();
+
+	/**
+	 * Start the batch and pump the engine tickers until it finishes
+	 * @return 0 if every character was generated, 1 if some failed, 2 on invalid arguments
+	 */
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** One iteration of the headless main loop (task graph, tickers, deferred commands) */
+	static void TickEngine(float DeltaTime);
+};
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Job Queue
+//
+// On-disk queue that lets several editor or commandlet processes share one
+// batch. The queue lives in Saved/MetaHumanGeneration/Queue/<BatchSeed>:
+//
+//   Manifest.json        - the batch, published once by the first worker
+//   Leases/<Index>.lease - held by the worker generating the entry, renewed while it runs
+//                          (the lease runs from the file's modification time, so a renewal
+//                          only touches the timestamp and the file never disappears)
+//   Done/<Index>.done    - written when the entry finished (generated or dead-lettered)
+//
+// Files are only ever created through a rename that fails when the target
+// exists, so exactly one worker wins each claim. A lease that is not renewed
+// before it expires (crashed or killed worker) can be taken over by any other
+// worker, so entries are never lost; an entry is never started again once its
+// Done marker exists, so finished characters are never duplicated.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetaHumanBatchPlanner.h"
+
+#include "MetaHumanBatchJobQueue.generated.h"
+
+/**
+ * Contents of a lease file
+ */
+USTRUCT()
+struct FMetaHumanBatchJobLease
+{
+	GENERATED_BODY()
+
+	/** Worker holding the lease */
+	UPROPERTY()
+	FString WorkerId;
+
+	/** Manifest entry index */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** How long after the file's last modification other workers may take the entry over */
+	UPROPERTY()
+	double DurationSeconds = 0.0;
+};
+
+/**
+ * Contents of a done marker
+ */
+USTRUCT()
+struct FMetaHumanBatchJobDone
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString WorkerId;
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** false if the entry was dead-lettered */
+	UPROPERTY()
+	bool bSuccess = false;
+
+	UPROPERTY()
+	FDateTime FinishedUtc;
+};
+
+/**
+ * Worker-side view of a shared batch queue
+ * Not thread safe - owned and used by the batch subsystem on the game thread.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanBatchJobQueue
+{
+public:
+	/**
+	 * Open the queue of a batch, publishing the manifest if this is the first worker
+	 * Workers that join later use the published manifest, so everyone works on the same entries.
+	 *
+	 * @param Manifest - Batch to publish if the queue does not exist yet
+	 * @param QueueDirectory - Queue location (empty = GetDefaultQueueDirectory(Manifest.BatchSeed))
+	 * @return The queue, or nullptr if the directory or manifest could not be written or read
+	 */
+	static TSharedPtr<FMetaHumanBatchJobQueue> OpenOrCreate(const FMetaHumanBatchManifest& Manifest, const FString& QueueDirectory = FString());
+
+	/** Saved/MetaHumanGeneration/Queue/<BatchSeed> */
+	static FString GetDefaultQueueDirectory(int32 BatchSeed);
+
+	/** <ComputerName>-<ProcessId>, unique among the processes sharing a queue */
+	static FString GetLocalWorkerId();
+
+	/** Manifest shared by every worker of the queue */
+	const FMetaHumanBatchManifest& GetManifest() const { return Manifest; }
+
+	const FString& GetWorkerId() const { return WorkerId; }
+
+	/** How long a claim or renewal keeps an entry reserved */
+	void SetLeaseDuration(double Seconds) { LeaseDurationSeconds = FMath::Max(10.0, Seconds); }
+	double GetLeaseDuration() const { return LeaseDurationSeconds; }
+
+	/**
+	 * Claim the next entry that is neither done nor leased (expired leases are taken over)
+	 * @return false if every remaining entry is currently leased by a live worker
+	 */
+	bool TryClaimNext(FMetaHumanBatchManifestEntry& OutEntry);
+
+	/**
+	 * Extend the lease of an entry held by this worker
+	 * @return false if the lease was lost (expired and taken over) - the caller must abandon the entry
+	 */
+	bool RenewLease(int32 Index);
+
+	/** Give an entry back without finishing it, so another worker can pick it up right away */
+	void ReleaseLease(int32 Index);
+
+	/** Record the entry as finished and drop its lease */
+	void MarkDone(int32 Index, bool bSuccess);
+
+	/** Whether every entry of the manifest has a done marker (checks the disk for entries not known to be done) */
+	bool IsComplete();
+
+	/** Entries known to be done, by any worker */
+	int32 GetDoneCount() const { return KnownDone.Num(); }
+
+	/** Entries leased by this worker */
+	const TSet<int32>& GetOwnedLeases() const { return OwnedLeases; }
+
+private:
+	FMetaHumanBatchJobQueue() = default;
+
+	FString GetLeasePath(int32 Index) const;
+	FString GetDonePath(int32 Index) const;
+
+	/** Whether the done marker of an entry exists, caching positive answers */
+	bool IsDone(int32 Index);
+
+	/** Create the lease file of an entry; fails if another lease exists */
+	bool CreateLease(int32 Index) const;
+	bool ReadLease(int32 Index, FMetaHumanBatchJobLease& OutLease) const;
+
+	/** UTC time at which a lease file expires (its modification time plus its duration) */
+	static FDateTime GetLeaseExpiry(const FString& LeasePath, const FMetaHumanBatchJobLease& Lease);
+
+	/** Try to remove an expired lease; only one of several workers racing for it succeeds */
+	bool TryBreakExpiredLease(int32 Index) const;
+
+	FString QueueDirectory;
+	FString WorkerId;
+	FMetaHumanBatchManifest Manifest;
+	double LeaseDurationSeconds = 300.0;
+
+	/** Position in Manifest.Entries where the next claim scan starts */
+	int32 ClaimCursor = 0;
+
+	TSet<int32> KnownDone;
+	TSet<int32> OwnedLeases;
+};
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Metrics
+//
+// Low-overhead timing and throughput bookkeeping for the batch generation
+// state machine. Stage durations go into fixed log-bucketed histograms, so
+// recording a sample is a couple of arithmetic ops and percentiles can be
+// read at any time without keeping the samples around.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MetaHumanBatchMetrics.generated.h"
+
+/**
+ * Latency and outcome summary of one stage
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanStageMetricsSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	FName Stage;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	int32 SuccessCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	int32 FailureCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MeanSeconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float P50Seconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float P95Seconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float P99Seconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MaxSeconds = 0.0f;
+};
+
+/**
+ * Metrics of a whole batch at a point in time
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanBatchMetricsSnapshot
+{
+	GENERATED_BODY()
+
+	/** Wall clock time since the batch was started */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float ElapsedSeconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	int32 CharactersCompleted = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	int32 CharactersFailed = 0;
+
+	/** Completed characters extrapolated to one hour of wall clock time */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float CharactersPerHour = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	TArray<FMetaHumanStageMetricsSnapshot> Stages;
+
+	/** Used physical memory when the batch started, now, and the highest sample seen */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float StartUsedPhysicalMB = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float UsedPhysicalMB = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float PeakUsedPhysicalMB = 0.0f;
+
+	/**
+	 * Change of used physical memory from one teardown collection to the next
+	 * Covers the whole process, jobs still in flight included - it settles near 0 over a batch when nothing leaks.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MeanCollectionMemoryDeltaMB = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MaxCollectionMemoryDeltaMB = 0.0f;
+
+	/**
+	 * Resident memory change per torn-down job: each collection's delta spread over the jobs released since the previous one
+	 * The mean is weighted by job, the max is that of the per-collection averages.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MeanJobMemoryDeltaMB = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	float MaxJobMemoryDeltaMB = 0.0f;
+
+	/** Free-form counters (cache hits, retries, ...) */
+	UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+	TMap<FName, int64> Counters;
+};
+
+/**
+ * Batch metrics accumulator
+ * Not thread safe - owned and updated by the batch subsystem on the game thread.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanBatchMetrics
+{
+public:
+	FMetaHumanBatchMetrics();
+
+	/** Clear everything and restart the batch clock */
+	void Reset();
+
+	/** Record one execution of a stage */
+	void RecordStage(FName Stage, double Seconds, bool bSuccess);
+
+	/** Record the end of a character */
+	void RecordCharacter(bool bSuccess);
+
+	/** Bump a free-form counter */
+	void IncrementCounter(FName Counter, int64 Delta = 1);
+
+	/** Record the process's used physical memory (the first sample of a batch is its baseline) */
+	void RecordMemory(uint64 UsedPhysicalBytes);
+
+	/**
+	 * Record the change of used physical memory since the previous collection
+	 * @param NumJobs - Jobs torn down since the previous collection, the per-job delta is shared out between them
+	 */
+	void RecordCollectionMemoryDelta(int64 DeltaBytes, int32 NumJobs);
+
+	/** Summarize the current state */
+	FMetaHumanBatchMetricsSnapshot GetSnapshot() const;
+
+	/** Write the snapshot as JSON; the file is replaced atomically */
+	bool WriteToFile(const FString& FilePath) const;
+
+	/** Saved/MetaHumanGeneration/Metrics */
+	static FString GetDefaultMetricsDirectory();
+
+private:
+	/** Log-bucketed histogram - bucket i covers [MinSeconds * Growth^i, MinSeconds * Growth^(i+1)) */
+	struct FStageHistogram
+	{
+		static constexpr int32 NumBuckets = 64;
+		static constexpr double MinSeconds = 0.01;
+		static constexpr double Growth = 1.25;
+
+		uint32 Buckets[NumBuckets] = {};
+		int32 SuccessCount = 0;
+		int32 FailureCount = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+
+		void Add(double Seconds);
+		double GetPercentile(double Percentile) const;
+	};
+
+	/** Stages in first-recorded order, so dumps keep the pipeline order */
+	TArray<FName> StageOrder;
+	TMap<FName, FStageHistogram> Stages;
+	TMap<FName, int64> Counters;
+
+	double StartTime = 0.0;
+	int32 CharactersCompleted = 0;
+	int32 CharactersFailed = 0;
+
+	uint64 StartUsedPhysical = 0;
+	uint64 LastUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+	int64 TotalCollectionMemoryDelta = 0;
+	int64 MaxCollectionMemoryDelta = 0;
+	int32 CollectionMemorySamples = 0;
+	int32 CollectionMemoryJobs = 0;
+	double MaxJobMemoryDelta = 0.0;
+};
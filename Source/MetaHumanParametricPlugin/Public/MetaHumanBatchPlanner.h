@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Batch Planner
+//
+// Expands a batch seed and a character count into a reproducible manifest.
+// Each manifest entry only stores its index and its own seed; the full body and
+// appearance configs are derived from that seed with a private FRandomStream
+// when a worker picks the entry up, so planning is cheap and any entry can be
+// regenerated on any machine.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MetaHumanParametricGenerator.h"
+
+#include "MetaHumanBatchPlanner.generated.h"
+
+/**
+ * A single planned character
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanBatchManifestEntry
+{
+	GENERATED_BODY()
+
+	/** Position of the entry within its batch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+	int32 Index = 0;
+
+	/** Seed of the per-entry random stream, derived from the batch seed and the index */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+	int32 Seed = 0;
+};
+
+/**
+ * A planned batch of characters
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanBatchManifest
+{
+	GENERATED_BODY()
+
+	/** Seed the entries were derived from */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+	int32 BatchSeed = 0;
+
+	/** Planned characters, in generation order */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+	TArray<FMetaHumanBatchManifestEntry> Entries;
+};
+
+/**
+ * MetaHuman Batch Planner
+ *
+ * Turns (BatchSeed, Count) into a manifest, either in memory or streamed to a
+ * JSON Lines file, and expands single entries into generator configs.
+ * Expansion only reads the entry's own seed, so the same entry always produces
+ * the same character regardless of which worker or machine expands it.
+ */
+UCLASS(BlueprintType)
+class METAHUMANPARAMETRICPLUGIN_API UMetaHumanBatchPlanner : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Plan a batch in memory
+	 *
+	 * @param BatchSeed - Seed of the whole batch
+	 * @param Count - Number of characters to plan
+	 * @param FirstIndex - Index of the first entry (lets several machines plan disjoint shards)
+	 * @return Manifest with Count entries
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|BatchPlanner")
+	static FMetaHumanBatchManifest PlanBatch(int32 BatchSeed, int32 Count, int32 FirstIndex = 0);
+
+	/**
+	 * Derive the seed of a single entry
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MetaHuman|BatchPlanner")
+	static int32 GetEntrySeed(int32 BatchSeed, int32 Index);
+
+	/**
+	 * Expand a manifest entry into the configs consumed by UMetaHumanParametricGenerator
+	 *
+	 * @param Entry - Entry to expand
+	 * @param QualityLevel - Quality level written into the body config
+	 * @param OutBodyConfig - Generated body config
+	 * @param OutAppearanceConfig - Generated appearance config
+	 * @param OutCharacterName - Deterministic character name for the entry
+	 */
+	static void ExpandEntry(
+		const FMetaHumanBatchManifestEntry& Entry,
+		EMetaHumanQualityLevel QualityLevel,
+		FMetaHumanBodyParametricConfig& OutBodyConfig,
+		FMetaHumanAppearanceConfig& OutAppearanceConfig,
+		FString& OutCharacterName);
+
+	/**
+	 * Derive a wardrobe variant of an expanded entry
+	 * Variants share the entry's face and body (and so its rig); only hair, hair
+	 * material parameters, clothing and garment colors are re-drawn, from a stream
+	 * seeded with the entry seed and the variant index.
+	 *
+	 * @param Entry - Entry the base configs were expanded from
+	 * @param VariantIndex - 0 returns the base wardrobe unchanged
+	 * @param BaseBodyConfig - Body config expanded from the entry (selects the hair pool)
+	 * @param BaseWardrobe - Wardrobe expanded from the entry
+	 * @param OutWardrobe - Variant wardrobe (gets its own HairParameters object)
+	 */
+	static void ExpandWardrobeVariant(
+		const FMetaHumanBatchManifestEntry& Entry,
+		int32 VariantIndex,
+		const FMetaHumanBodyParametricConfig& BaseBodyConfig,
+		const FMetaHumanWardrobeConfig& BaseWardrobe,
+		FMetaHumanWardrobeConfig& OutWardrobe);
+
+	/** Asset name of a wardrobe variant: <BaseName>_V<NN>, variant 0 keeps the base name */
+	static FString GetVariantName(const FString& BaseName, int32 VariantIndex);
+
+	/**
+	 * Every wardrobe item path an entry or variant can draw, without duplicates
+	 * Entries only store seeds, so this covers any manifest the planner produces.
+	 */
+	static void GetWardrobeCatalog(TArray<FString>& OutItemPaths);
+
+	/**
+	 * Stream a manifest to disk as JSON Lines (one entry per line)
+	 * Entries are written as they are planned, so large batches never sit in memory.
+	 *
+	 * @param BatchSeed - Seed of the whole batch
+	 * @param Count - Number of characters to plan
+	 * @param FilePath - Target file
+	 * @param bExpandConfigs - Also write the expanded body and appearance configs, for review
+	 * @param QualityLevel - Quality level used when expanding
+	 * @param FirstIndex - Index of the first entry
+	 * @return true if the whole manifest was written
+	 */
+	static bool WriteManifestToFile(
+		int32 BatchSeed,
+		int32 Count,
+		const FString& FilePath,
+		bool bExpandConfigs = false,
+		EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic,
+		int32 FirstIndex = 0);
+
+	/**
+	 * Load a manifest written by WriteManifestToFile
+	 * Only the index and seed of each line are read; configs are re-expanded from the seed.
+	 */
+	static bool LoadManifestFromFile(const FString& FilePath, FMetaHumanBatchManifest& OutManifest);
+
+	/** Saved/MetaHumanGeneration/Manifests */
+	static FString GetDefaultManifestDirectory();
+};
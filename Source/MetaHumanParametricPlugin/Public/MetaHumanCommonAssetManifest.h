@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Common Asset Manifest
+//
+// Content hashes of the shared packages every assembly writes to
+// <BuildPath>/Common (skeletons, base materials, ...). The native build
+// regenerates them for each character; a package whose content hash and file
+// on disk still match the record is not saved again:
+//
+//   Saved/MetaHumanGeneration/CommonAssets.txt   (header line, then "<Package>\t<Hash>\t<Size>\t<Timestamp>" per line)
+//
+// The size and timestamp of the file are recorded with the hash, so a file
+// that was replaced or deleted behind the manifest's back is written again.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Static access to the common asset manifest
+ * Game thread only.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanCommonAssetManifest
+{
+public:
+	/**
+	 * SHA1 of the serialized bytes of every object in the package, subobjects included
+	 * @return Hex digest, or an empty string for a package without objects
+	 */
+	static FString ComputeContentHash(UPackage* Package);
+
+	/**
+	 * The file of the package was written from content with this hash and is unchanged since
+	 * @param OutFileSize - Size of the file on disk when up to date
+	 */
+	static bool IsUpToDate(const UPackage* Package, const FString& PackageFileName, const FString& ContentHash, int64& OutFileSize);
+
+	/** Record the hash of a package that was just written to PackageFileName (synchronously, the file must be on disk) */
+	static void Record(const UPackage* Package, const FString& PackageFileName, const FString& ContentHash);
+
+	/** Write the manifest if Record changed it */
+	static void SaveIfDirty();
+
+	/** Saved/MetaHumanGeneration/CommonAssets.txt */
+	static FString GetManifestFilePath();
+};
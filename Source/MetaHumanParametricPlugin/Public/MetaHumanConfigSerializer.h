@@ -11,6 +11,19 @@
 #include "MetaHumanParametricGenerator.h"
 #include "MetaHumanConfigSerializer.generated.h"
 
+/** One quality level of an assembled character and the folder its assets were built in */
+USTRUCT()
+struct FMetaHumanGenerationSessionOutput
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    EMetaHumanQualityLevel QualityLevel = EMetaHumanQualityLevel::Cinematic;
+
+    UPROPERTY()
+    FString OutputPath;
+};
+
 USTRUCT()
 struct FMetaHumanGenerationSession
 {
@@ -37,6 +50,14 @@ struct FMetaHumanGenerationSession
     UPROPERTY()
     FString GenerationStatus;
 
+    /** High-resolution texture download chosen for the character */
+    UPROPERTY()
+    EMetaHumanTextureResolution TextureResolution = EMetaHumanTextureResolution::Res2k;
+
+    /** Every quality level the character was assembled at - with several levels each has its own folder below OutputPath */
+    UPROPERTY()
+    TArray<FMetaHumanGenerationSessionOutput> Outputs;
+
     FMetaHumanGenerationSession()
     {
         Timestamp = FDateTime::Now();
@@ -72,10 +93,17 @@ public:
         const FString& OutputPath,
         const FMetaHumanBodyParametricConfig& BodyConfig,
         const FMetaHumanAppearanceConfig& AppearanceConfig,
-        const FString& Status = TEXT("Started"));
+        const FString& Status = TEXT("Started"),
+        EMetaHumanTextureResolution TextureResolution = EMetaHumanTextureResolution::Res2k);
 
     static bool UpdateSessionStatus(const FString& CharacterName, const FString& NewStatus);
 
+    /** Update the status and record the quality levels the character was assembled at, with their output paths */
+    static bool UpdateSessionOutputs(
+        const FString& CharacterName,
+        const FString& NewStatus,
+        const TArray<FMetaHumanGenerationSessionOutput>& Outputs);
+
     static FMetaHumanGenerationSession CreateSessionFromCurrentGeneration(
         const FString& CharacterName,
         const FString& OutputPath,
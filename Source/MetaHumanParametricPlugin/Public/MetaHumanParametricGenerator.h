@@ -148,6 +148,263 @@ struct FMetaHumanAppearanceConfig
 	FMetaHumanWardrobeConfig WardrobeConfig;
 };
 
+/**
+ * Which part of the generation workflow failed
+ */
+UENUM(BlueprintType)
+enum class EMetaHumanGenerationFailure : uint8
+{
+	None UMETA(DisplayName = "None"),
+	Auth UMETA(DisplayName = "Authentication"),
+	Create UMETA(DisplayName = "Create Character"),
+	Configure UMETA(DisplayName = "Configure Body/Appearance"),
+	Wardrobe UMETA(DisplayName = "Wardrobe"),
+	Rig UMETA(DisplayName = "AutoRig"),
+	Texture UMETA(DisplayName = "Texture Download"),
+	Assemble UMETA(DisplayName = "Assemble")
+};
+
+/**
+ * Size of the high-resolution textures downloaded for a character
+ */
+UENUM(BlueprintType)
+enum class EMetaHumanTextureResolution : uint8
+{
+	/** Look it up from the assembly quality level (UMetaHumanParametricGenerator::GetTextureResolutionForQuality) */
+	FromQuality UMETA(DisplayName = "From Quality Level"),
+	/** Keep the synthesized textures, nothing is downloaded */
+	None UMETA(DisplayName = "No High-Res Download"),
+	Res2k UMETA(DisplayName = "2k"),
+	Res4k UMETA(DisplayName = "4k"),
+	Res8k UMETA(DisplayName = "8k")
+};
+
+/**
+ * Timings of a single AssembleCharacter call, in seconds
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanAssemblyStats
+{
+	GENERATED_BODY()
+
+	/** Texture source data request */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	float TextureSeconds = 0.0f;
+
+	/** Build parameters, including the pipeline lookup */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	float PipelineSeconds = 0.0f;
+
+	/** The pipeline class came from the pipeline cache and was not loaded again */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	bool bPipelineCacheHit = false;
+
+	/** Native pipeline build (FMetaHumanCharacterEditorBuild) */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	float BuildSeconds = 0.0f;
+
+	/** Saving the packages of the assembly (character, build folder, common folder); with bAsyncSave only serialization and queuing */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	float SaveSeconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	int32 SavedPackages = 0;
+
+	/** The build succeeded but some of its packages could not be saved - the assembly counts as failed */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	bool bSaveFailed = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	int64 SavedBytes = 0;
+
+	/** Common folder packages left alone because the same content is already on disk (SkippedBytes = their file size) */
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	int32 SkippedPackages = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Assembly Stats")
+	int64 SkippedBytes = 0;
+};
+
+/**
+ * Result of UMetaHumanParametricGenerator::BenchmarkBodyConfiguration, average milliseconds per call
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanBodyBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Body Benchmark")
+	int32 Iterations = 0;
+
+	/** ConfigureBodyParameters - one body state, one full mesh update */
+	UPROPERTY(BlueprintReadOnly, Category = "Body Benchmark")
+	float SinglePassMs = 0.0f;
+
+	/** Previous path - body type, delta scale and constraints each applied through the editor subsystem */
+	UPROPERTY(BlueprintReadOnly, Category = "Body Benchmark")
+	float IncrementalMs = 0.0f;
+};
+
+/**
+ * Optional settings of a single AssembleCharacter call
+ */
+USTRUCT(BlueprintType)
+struct FMetaHumanAssemblyOptions
+{
+	GENERATED_BODY()
+
+	/** Name of the assembled assets and of the session record (empty = character asset name) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	FString NameOverride;
+
+	/** Request high-resolution textures before building (off when the caller already fetched them) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	bool bFetchTextures = true;
+
+	/** Size of the textures requested by bFetchTextures */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	EMetaHumanTextureResolution TextureResolution = EMetaHumanTextureResolution::FromQuality;
+
+	/**
+	 * Write the assembled packages from the engine's async file writer instead of waiting for each file
+	 * The session is left at "Saving"; wait for UMetaHumanParametricGenerator::WaitForAssemblySaves
+	 * (or poll HasPendingAssemblySaves) before treating the output as on disk.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	bool bAsyncSave = false;
+
+	/** Do not save common folder packages whose content hash matches their file on disk (see FMetaHumanCommonAssetManifest) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	bool bSkipUnchangedCommonAssets = true;
+
+	/**
+	 * Appended to the common folder (<BuildPath>/Common<Suffix>)
+	 * Processes that assemble into the same build path at once need their own common folder -
+	 * they would otherwise write the same shared packages concurrently.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assembly Options")
+	FString CommonFolderSuffix;
+};
+
+/**
+ * Resumable steps of PrepareAndRigCharacter, in execution order
+ */
+UENUM(BlueprintType)
+enum class EMetaHumanPrepareStep : uint8
+{
+	SaveSession UMETA(DisplayName = "Save Session"),
+	Authenticate UMETA(DisplayName = "Authenticate"),
+	CreateCharacter UMETA(DisplayName = "Create Character"),
+	ConfigureBody UMETA(DisplayName = "Configure Body"),
+	ConfigureAppearance UMETA(DisplayName = "Configure Appearance"),
+	AddHair UMETA(DisplayName = "Add Hair"),
+	AddClothing UMETA(DisplayName = "Add Clothing"),
+	WardrobeColors UMETA(DisplayName = "Wardrobe Colors"),
+	PreviewBuild UMETA(DisplayName = "Preview Build"),
+	StartAutoRig UMETA(DisplayName = "Start AutoRig"),
+	Done UMETA(DisplayName = "Done")
+};
+
+/**
+ * State of a character preparation that is run one step at a time
+ * Fill in the inputs, then call UMetaHumanParametricGenerator::RunPrepareStep until IsDone().
+ */
+USTRUCT()
+struct FMetaHumanPrepareContext
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString CharacterName;
+
+	UPROPERTY()
+	FString OutputPath;
+
+	UPROPERTY()
+	FMetaHumanBodyParametricConfig BodyConfig;
+
+	UPROPERTY()
+	FMetaHumanAppearanceConfig AppearanceConfig;
+
+	/** Block in the Authenticate step instead of yielding until the async login check returns */
+	UPROPERTY()
+	bool bBlockingAuth = false;
+
+	/** Next step to run */
+	UPROPERTY()
+	EMetaHumanPrepareStep Step = EMetaHumanPrepareStep::SaveSession;
+
+	/** Look the face up in the rig cache (FMetaHumanRigCache) before starting AutoRig */
+	UPROPERTY()
+	bool bUseRigCache = true;
+
+	/** Set by the StartAutoRig step when the rig was committed from the cache */
+	UPROPERTY()
+	bool bRigCacheHit = false;
+
+	/** Rig cache key of the face as sent to AutoRig (the key is taken before rigging, which may change the face state) */
+	UPROPERTY()
+	FString RigCacheKey;
+
+	/**
+	 * Run the Preview collection build in the PreviewBuild step
+	 * Without clothing only the editor viewport shows its result - AssembleCharacter builds the collection
+	 * itself, so unattended batches can turn it off. Characters with clothing always get it, it initializes
+	 * their Chaos cloth.
+	 */
+	UPROPERTY()
+	bool bBuildPreview = true;
+
+	/** Time spent in the PreviewBuild step (0 when it was skipped) */
+	UPROPERTY()
+	float PreviewBuildSeconds = 0.0f;
+
+	/** Texture download planned for the character, recorded in its session */
+	UPROPERTY()
+	EMetaHumanTextureResolution TextureResolution = EMetaHumanTextureResolution::Res2k;
+
+	/**
+	 * Create the character as a copy of an initialized prototype of its template type
+	 * instead of initializing it from scratch (see CreateCharacterFromPrototype)
+	 */
+	UPROPERTY()
+	bool bUseCharacterPrototype = false;
+
+	/** Time spent in the CreateCharacter step, including PrototypeInitSeconds */
+	UPROPERTY()
+	float CreateCharacterSeconds = 0.0f;
+
+	/** Part of CreateCharacterSeconds spent initializing a new prototype (first character of a template type only) */
+	UPROPERTY()
+	float PrototypeInitSeconds = 0.0f;
+
+	/** Next clothing item to add in the AddClothing step */
+	UPROPERTY()
+	int32 ClothingIndex = 0;
+
+	/** Character created by the CreateCharacter step */
+	UPROPERTY()
+	TObjectPtr<UMetaHumanCharacter> Character;
+
+	/** Set when a step returned false */
+	UPROPERTY()
+	EMetaHumanGenerationFailure Failure = EMetaHumanGenerationFailure::None;
+
+	/** Set by the last step when it is waiting on something external rather than doing work */
+	bool bWaiting = false;
+
+	/** Result of the async login check, written by the callback */
+	struct FAuthCheck
+	{
+		std::atomic<bool> bComplete = false;
+		std::atomic<bool> bLoggedIn = false;
+		double StartTime = 0.0;
+	};
+	TSharedPtr<FAuthCheck, ESPMode::ThreadSafe> AuthCheck;
+
+	bool IsDone() const { return Step == EMetaHumanPrepareStep::Done; }
+};
+
 /**
  * MetaHuman 参数化生成器
  *
@@ -188,6 +445,34 @@ public:
 		const FMetaHumanAppearanceConfig& AppearanceConfig,
 		UMetaHumanCharacter*& OutCharacter);
 
+	/**
+	 * Same as PrepareAndRigCharacter, also reports which step failed
+	 * @param OutFailure - None on success, otherwise the failing step
+	 */
+	static bool PrepareAndRigCharacter(
+		const FString& CharacterName,
+		const FString& OutputPath,
+		const FMetaHumanBodyParametricConfig& BodyConfig,
+		const FMetaHumanAppearanceConfig& AppearanceConfig,
+		UMetaHumanCharacter*& OutCharacter,
+		EMetaHumanGenerationFailure& OutFailure);
+
+	/**
+	 * Run the next step of a preparation
+	 * Each step is one bounded piece of editor work (create, configure, add one clothing item, ...),
+	 * so callers can spread a preparation over several frames.
+	 *
+	 * @param Context - Preparation state, advanced in place
+	 * @return false if the step failed (Context.Failure says which), true otherwise - including while waiting
+	 */
+	static bool RunPrepareStep(FMetaHumanPrepareContext& Context);
+
+	/**
+	 * Remove any existing face rig and start AutoRig (async, returns immediately)
+	 * Used by PrepareAndRigCharacter and to retry only the rig of an existing character.
+	 */
+	static bool StartAutoRig(UMetaHumanCharacter* Character);
+
 	/**
 	 * Step 2: 组装角色（在 AutoRig 完成后调用）
 	 * 此函数会：
@@ -200,7 +485,7 @@ public:
 	 * @param Character - 已完成 rigging 的角色资产
 	 * @param OutputPath - 输出路径
 	 * @param QualityLevel - 质量级别
-	 * @return 是否成功组装角色
+	 * @return 是否成功组装角色并保存其所有资产（任一包保存失败即返回 false）
 	 */
 	UFUNCTION(BlueprintCallable, Category = "MetaHuman|Generation")
 	static bool AssembleCharacter(
@@ -208,6 +493,53 @@ public:
 		const FString& OutputPath,
 		EMetaHumanQualityLevel QualityLevel);
 
+	/**
+	 * Same as AssembleCharacter, also reports how long each assembly step took
+	 */
+	static bool AssembleCharacter(
+		UMetaHumanCharacter* Character,
+		const FString& OutputPath,
+		EMetaHumanQualityLevel QualityLevel,
+		FMetaHumanAssemblyStats& OutStats);
+
+	/**
+	 * Same as AssembleCharacter, with per-call options
+	 * Assembling one rigged character several times under different NameOverrides
+	 * produces independent MetaHumans that share the face rig.
+	 */
+	static bool AssembleCharacter(
+		UMetaHumanCharacter* Character,
+		const FString& OutputPath,
+		EMetaHumanQualityLevel QualityLevel,
+		const FMetaHumanAssemblyOptions& Options,
+		FMetaHumanAssemblyStats& OutStats);
+
+	/**
+	 * Assemble one rigged character at several quality levels, each with the pipeline of its level
+	 * The rig and the texture download (one request, at the largest resolution any level uses) are
+	 * shared, so every level after the first only costs its build and save. With more than one level
+	 * each is built under GetQualityOutputPath; the session is updated once all of them are done.
+	 * @param OutStats - One entry per assembled level, in the order of QualityLevels
+	 */
+	static bool AssembleCharacter(
+		UMetaHumanCharacter* Character,
+		const FString& OutputPath,
+		const TArray<EMetaHumanQualityLevel>& QualityLevels,
+		const FMetaHumanAssemblyOptions& Options,
+		TArray<FMetaHumanAssemblyStats>& OutStats);
+
+	/** Build path of one level of a multi-quality assembly: OutputPath itself for a single level, otherwise OutputPath/<Level> */
+	static FString GetQualityOutputPath(
+		const FString& OutputPath,
+		EMetaHumanQualityLevel QualityLevel,
+		const TArray<EMetaHumanQualityLevel>& QualityLevels);
+
+	/** Packages saved with FMetaHumanAssemblyOptions::bAsyncSave (by any assembly) are still being written */
+	static bool HasPendingAssemblySaves();
+
+	/** Block until every async package write has reached the disk */
+	static void WaitForAssemblySaves();
+
 
 	UFUNCTION(BlueprintCallable, Category = "MetaHuman|Generation")
 	static FString GetRiggingStatusString(UMetaHumanCharacter* Character);
@@ -252,7 +584,77 @@ public:
 		UMetaHumanCharacter* Character,
 		const FMetaHumanWardrobeColorConfig& ColorConfig);
 
-	static bool DownloadTextureSourceData(UMetaHumanCharacter* Character);
+	/**
+	 * Start the high-resolution texture download of a character
+	 * @param Resolution - Texture size to request; None and FromQuality request nothing
+	 * @return true if the character has high-resolution textures or the download is running
+	 */
+	static bool DownloadTextureSourceData(UMetaHumanCharacter* Character, EMetaHumanTextureResolution Resolution = EMetaHumanTextureResolution::Res2k);
+
+	/**
+	 * Texture download of a quality level: 2k for Cinematic and High, none for Medium and Low
+	 * The optimized levels bake their textures down far below 2k, so a download would only cost import time.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MetaHuman|Textures")
+	static EMetaHumanTextureResolution GetTextureResolutionForQuality(EMetaHumanQualityLevel QualityLevel);
+
+	/** Resolution, or the one of QualityLevel for FromQuality */
+	static EMetaHumanTextureResolution ResolveTextureResolution(EMetaHumanTextureResolution Resolution, EMetaHumanQualityLevel QualityLevel);
+
+	/** Largest resolution Resolution resolves to over the quality levels (None if none of them downloads) */
+	static EMetaHumanTextureResolution ResolveTextureResolution(EMetaHumanTextureResolution Resolution, const TArray<EMetaHumanQualityLevel>& QualityLevels);
+
+	/** Texture size in pixels (0 when nothing is downloaded) */
+	static int32 GetTextureResolutionSize(EMetaHumanTextureResolution Resolution);
+
+	/**
+	 * Replace the hair and outfits of a character and apply the wardrobe's material parameters
+	 * Leaves the face, body and rig untouched, so it can be used on a rigged character.
+	 * @param bBuildPreview - Refresh the viewport preview afterwards (not needed before AssembleCharacter; always done when the wardrobe has clothing)
+	 */
+	static bool ApplyWardrobe(UMetaHumanCharacter* Character, const FMetaHumanWardrobeConfig& WardrobeConfig, bool bBuildPreview = true);
+
+	/** Trigger a preview build of the character's collection (initializes Chaos clothing) */
+	static bool BuildCollectionPreview(UMetaHumanCharacter* Character);
+
+	/**
+	 * Create a character asset as a duplicate of an initialized prototype of its template type
+	 * The prototype is created and initialized (InitializeMetaHumanCharacter) on first use and kept
+	 * in the transient package until ReleaseCharacterPrototypes, so later characters skip the model
+	 * and data loading; each copy is still registered for editing on its own.
+	 * @param OutPrototypeInitSeconds - Time this call spent initializing the prototype (0 if it existed)
+	 */
+	static UMetaHumanCharacter* CreateCharacterFromPrototype(
+		const FString& PackagePath,
+		const FString& CharacterName,
+		EMetaHumanCharacterTemplateType TemplateType,
+		double& OutPrototypeInitSeconds);
+
+	/** Drop the prototypes kept by CreateCharacterFromPrototype */
+	static void ReleaseCharacterPrototypes();
+
+	/**
+	 * End-of-job teardown of a character that will not be edited again
+	 * Removes it from the MetaHuman editor subsystem and clears RF_Standalone on its package and on the
+	 * packages assembled from it, so the next garbage collection frees them.
+	 * Packages with unsaved changes are kept unless bDiscardUnsaved is set.
+	 * @param AssemblyFolders - Build folders of its assemblies (<OutputPath>/<AssemblyName>)
+	 * @param bDiscardUnsaved - The caller saved everything it wants to keep (batch jobs): unsaved changes are
+	 *                          thrown away and their objects marked as garbage, so failed jobs do not stay resident
+	 * @return Number of packages released
+	 */
+	static int32 ReleaseCharacter(UMetaHumanCharacter* Character, const TArray<FString>& AssemblyFolders, bool bDiscardUnsaved = false);
+
+	/**
+	 * Time ConfigureBodyParameters against the incremental path it replaced
+	 * Both run Iterations times, interleaved; the character's body state is restored afterwards.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MetaHuman|Body")
+	static bool BenchmarkBodyConfiguration(
+		UMetaHumanCharacter* Character,
+		const FMetaHumanBodyParametricConfig& BodyConfig,
+		int32 Iterations,
+		FMetaHumanBodyBenchmarkResult& OutResult);
 
 private: 
 	static UMetaHumanCharacterEditorSubsystem* getEditorSubsystem();
@@ -260,6 +662,21 @@ private:
 private:
 	// ========== 内部辅助函数 ==========
 
+	/** AssembleCharacter at one quality level, without the session status update - fails when a package could not be saved */
+	static bool AssembleCharacterAtQuality(
+		UMetaHumanCharacter* Character,
+		const FString& OutputPath,
+		EMetaHumanQualityLevel QualityLevel,
+		const FMetaHumanAssemblyOptions& Options,
+		FMetaHumanAssemblyStats& OutStats);
+
+	/** Mark the session of an assembly Completed (Saving while async writes are in flight) and record the output path of each level */
+	static void UpdateAssembledSessionStatus(
+		UMetaHumanCharacter* Character,
+		const FString& OutputPath,
+		const TArray<EMetaHumanQualityLevel>& QualityLevels,
+		const FMetaHumanAssemblyOptions& Options);
+
 	/**
 	 * 步骤 1: 创建基础 MetaHuman Character 资产
 	 */
@@ -270,11 +687,20 @@ private:
 
 	/**
 	 * 步骤 2: 配置身体参数（参数化系统）
+	 * Body type, delta scale and constraints are applied to one body state, followed by a single full mesh update and commit.
 	 */
 	static bool ConfigureBodyParameters(
 		UMetaHumanCharacter* Character,
 		const FMetaHumanBodyParametricConfig& BodyConfig);
 
+	/**
+	 * Previous body configuration path, kept as the BenchmarkBodyConfiguration baseline
+	 * Every editor subsystem setter updates the body mesh on its own before the final commit.
+	 */
+	static bool ConfigureBodyParametersIncremental(
+		UMetaHumanCharacter* Character,
+		const FMetaHumanBodyParametricConfig& BodyConfig);
+
 	/**
 	 * 步骤 3: 配置外观（皮肤、眼睛、睫毛等）
 	 */
@@ -293,7 +719,7 @@ private:
 	 * 下载纹理源数据的实际实现函数
 	 * 线程安全的实现，处理后台线程调用
 	 */
-	static bool DownloadTextureSourceData_Impl(UMetaHumanCharacter* Character, UMetaHumanCharacterEditorSubsystem* EditorSubsystem);
+	static bool DownloadTextureSourceData_Impl(UMetaHumanCharacter* Character, UMetaHumanCharacterEditorSubsystem* EditorSubsystem, EMetaHumanTextureResolution Resolution);
 
 	/**
 	 * 辅助：将身体测量值转换为约束数组
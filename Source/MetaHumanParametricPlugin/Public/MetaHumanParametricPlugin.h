@@ -48,6 +48,7 @@ private:
 	static void OnCheckRiggingStatus();
 	static void OnStep2Assemble();
 	static void OnExportWithAnimBP();
+	static void OnBenchmarkBodyConfiguration();
 
 	/** Authentication menu command callbacks */
 	static void OnCheckAuthentication();
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Rig Cache
+//
+// Local content-addressed store of AutoRig results. The key is a hash of the
+// face identity state (which already carries the fit to the body) and the rig
+// type; the value is the face DNA the cloud service returned:
+//
+//   Saved/MetaHumanGeneration/RigCache/<Key>.dna
+//
+// A character whose face state is already in the cache gets the stored DNA
+// committed directly, skipping RemoveFaceRig + AutoRigFace. Re-running a
+// session after a crash or a wardrobe/skin tweak therefore costs seconds.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMetaHumanCharacter;
+
+/**
+ * Static access to the on-disk rig cache
+ * Game thread only (uses the MetaHuman character editor subsystem).
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanRigCache
+{
+public:
+	/**
+	 * Cache key of a character's current face state and the rig type used by the generator
+	 * @return Hex digest, or an empty string if the face state is not available
+	 */
+	static FString ComputeKey(UMetaHumanCharacter* Character);
+
+	/**
+	 * Commit the cached DNA of Key to the character
+	 * @return true if the character is rigged from the cache, false on a miss or an unreadable entry
+	 */
+	static bool TryApply(UMetaHumanCharacter* Character, const FString& Key);
+
+	/**
+	 * Store the face DNA of a rigged character
+	 * @param Key - ComputeKey of the character taken before AutoRig, the key later lookups compute
+	 * Existing entries are kept, so concurrent writers of the same face never clash.
+	 */
+	static bool Store(UMetaHumanCharacter* Character, const FString& Key);
+
+	/** Saved/MetaHumanGeneration/RigCache */
+	static FString GetCacheDirectory();
+
+private:
+	static FString GetEntryPath(const FString& Key);
+};
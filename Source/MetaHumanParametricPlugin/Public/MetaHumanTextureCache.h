@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Texture Cache
+//
+// Local content-addressed store of the high-resolution textures returned by
+// RequestHighResolutionTextures. Face and body sets are cached separately,
+// each keyed by everything the service synthesizes them from:
+//
+//   Face - FaceTextureIndex, skin tone (U, V), resolution
+//   Body - BodyTextureIndex, skin tone (U, V), resolution
+//
+//   Saved/MetaHumanGeneration/TextureCache/<Key>.mhtex
+//
+// Entries are touched when they are used; once the directory grows past its
+// size limit the least recently used entries are deleted first.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMetaHumanCharacter;
+
+/**
+ * Static access to the on-disk texture cache
+ * Game thread only.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanTextureCache
+{
+public:
+	/**
+	 * Give the character its high-resolution face and body textures from the cache
+	 * Only applies when both sets are cached, otherwise the download is needed anyway.
+	 * @param Resolution - Texture size the download would request (see UMetaHumanParametricGenerator::GetTextureResolutionSize)
+	 * @return true if the character now has high-resolution textures
+	 */
+	static bool TryApply(UMetaHumanCharacter* Character, int32 Resolution);
+
+	/**
+	 * Store the high-resolution textures of a character, then trim the cache to MaxCacheBytes
+	 * @param Resolution - Texture size that was downloaded; smaller textures are not stored
+	 * @param OutEvictedCount - Number of entries deleted by the trim
+	 * @return true if both sets are cached afterwards
+	 */
+	static bool Store(UMetaHumanCharacter* Character, int32 Resolution, int64 MaxCacheBytes, int32& OutEvictedCount);
+
+	/**
+	 * Delete least recently used entries until the cache is no larger than MaxCacheBytes
+	 * @return Number of entries deleted
+	 */
+	static int32 Trim(int64 MaxCacheBytes);
+
+	/** Saved/MetaHumanGeneration/TextureCache */
+	static FString GetCacheDirectory();
+
+	/** Cache keys of the character's current skin settings at a texture size */
+	static FString GetFaceKey(const UMetaHumanCharacter* Character, int32 Resolution);
+	static FString GetBodyKey(const UMetaHumanCharacter* Character, int32 Resolution);
+
+private:
+	static FString GetEntryPath(const FString& Key);
+};
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Wardrobe Catalog
+//
+// Index of every UMetaHumanWardrobeItem asset, grouped by package folder.
+// Built from the asset registry once, then kept current from its
+// added/removed/renamed events and written to
+//
+//   Saved/MetaHumanGeneration/WardrobeCatalog.txt   (header line, then one object path per line)
+//
+// so a restarted editor can answer queries before the registry has finished
+// its initial scan. The index is rebuilt from the registry once that scan ends.
+//
+// Queries are (slot, content root) pairs. Their item lists are resolved from the
+// folder index on first use and cached until an item under that root changes,
+// so repeated random picks are O(1).
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+/**
+ * Process-wide wardrobe item index
+ * Game thread only.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanWardrobeCatalog
+{
+public:
+	/** The catalog, loaded or built on first access */
+	static FMetaHumanWardrobeCatalog& Get();
+
+	/** Save a changed index and unbind from the asset registry (module shutdown) */
+	static void TearDown();
+
+	~FMetaHumanWardrobeCatalog();
+
+	/**
+	 * All wardrobe items under ContentPath (recursive) offered for SlotName
+	 * The asset registry does not record which slot an item fits, so the slot only
+	 * separates the cached queries - callers pass the content root of that slot.
+	 * The returned array is only valid until the catalog next changes.
+	 */
+	const TArray<FSoftObjectPath>& GetItems(const FName& SlotName, const FString& ContentPath);
+
+	/**
+	 * Random item of GetItems(SlotName, ContentPath)
+	 * @param Stream - Draw from this stream instead of the global random generator
+	 * @return Object path, or an empty string if there is no item under ContentPath
+	 */
+	FString PickRandom(const FName& SlotName, const FString& ContentPath, FRandomStream* Stream = nullptr);
+
+	/** Number of indexed wardrobe items */
+	int32 Num() const;
+
+	/** Saved/MetaHumanGeneration/WardrobeCatalog.txt */
+	static FString GetCatalogFilePath();
+
+private:
+	FMetaHumanWardrobeCatalog();
+
+	/** Replace the index with a registry query, then save it */
+	void RebuildFromRegistry();
+	bool LoadFromFile();
+	void SaveIfDirty();
+
+	void AddItem(const FSoftObjectPath& ItemPath);
+	void RemoveItem(const FSoftObjectPath& ItemPath);
+
+	/** Drop the cached queries whose content root contains the item */
+	void InvalidateQueries(const FSoftObjectPath& ItemPath);
+
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleFilesLoaded();
+
+	static bool IsWardrobeItem(const FAssetData& AssetData);
+
+	/** Package folder (e.g. /Game/GoodWI/Upper) -> items directly inside it */
+	TMap<FString, TArray<FSoftObjectPath>> ItemsByFolder;
+
+	/** "<Slot>|<ContentPath>" -> resolved items */
+	TMap<FString, TArray<FSoftObjectPath>> QueryCache;
+
+	bool bDirty = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle FilesLoadedHandle;
+
+	static TUniquePtr<FMetaHumanWardrobeCatalog> Instance;
+};
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// MetaHuman Wardrobe Preloader
+//
+// Streams the wardrobe items of a batch in one async request when the batch
+// starts and keeps them resident until it ends. AddWardrobeItem then finds
+// every hair and clothing item already in memory instead of blocking the game
+// thread in LoadSynchronous the first time a character draws it.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+/**
+ * One batch-wide async load of wardrobe items
+ * Game thread only.
+ */
+class METAHUMANPARAMETRICPLUGIN_API FMetaHumanWardrobePreloader
+{
+public:
+	~FMetaHumanWardrobePreloader();
+
+	/**
+	 * Request every item asynchronously in a single streamable handle
+	 * Replaces (and releases) an earlier request.
+	 */
+	void Preload(const TArray<FString>& ItemPaths);
+
+	/** Drop the handle, the items may be garbage collected afterwards */
+	void Release();
+
+	/** A request is held, loading or loaded */
+	bool IsActive() const { return Handle.IsValid(); }
+
+	/** Every requested item has finished loading (or failed to) */
+	bool IsComplete() const;
+
+	int32 GetNumRequested() const { return RequestedPaths.Num(); }
+
+	/** Requested items that are in memory now */
+	int32 GetNumLoaded() const;
+
+	/** Time since Preload (read it when IsComplete() turns true for the load time) */
+	double GetLoadSeconds() const;
+
+	/** Log the requested items that did not load (wrong path or not a wardrobe item) */
+	void LogMissingItems() const;
+
+private:
+	FStreamableManager StreamableManager;
+	TSharedPtr<FStreamableHandle> Handle;
+	TArray<FSoftObjectPath> RequestedPaths;
+	double StartTime = 0.0;
+};
@@ -1,4 +1,5 @@
 #!/usr/bin/env python3
+import argparse
 import os
 import sys
 import time
@@ -11,6 +12,9 @@ PROJECT_ROOT = SCRIPT_DIR.parent.parent
 HEARTBEAT_FILE = PROJECT_ROOT / "Saved" / "heartbeat.txt"
 
 STARTUP_TIME = 120
+# The commandlet skips the level editor, Slate and asset browser startup
+COMMANDLET_STARTUP_TIME = 30
+COMMANDLET_NAME = "MetaHumanBatchGeneration"
 HEARTBEAT_TIMEOUT = 300
 HEARTBEAT_CHECK_INTERVAL = 5
 editor_exe_candidates = [
@@ -35,11 +39,73 @@ def find_editor_exe():
 
     raise FileNotFoundError(f"Unreal Editor not found in any of: {editor_exe_candidates}")
 
+def find_editor_cmd_exe(editor_exe):
+    # UnrealEditor-Cmd.exe sits next to UnrealEditor.exe and keeps the console attached
+    cmd_exe = Path(editor_exe).with_name("UnrealEditor-Cmd.exe")
+    if not cmd_exe.exists():
+        raise FileNotFoundError(f"UnrealEditor-Cmd.exe not found next to {editor_exe}")
+    return str(cmd_exe)
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Restart the editor whenever its heartbeat stops")
+    parser.add_argument("--commandlet", action="store_true",
+                        help="run the headless batch generation commandlet instead of the full editor")
+    parser.add_argument("--manifest", help="manifest file passed to the commandlet (-Manifest=)")
+    parser.add_argument("--count", type=int, help="characters to generate when no manifest is given (-Count=)")
+    parser.add_argument("--seed", type=int, help="batch seed used with --count (-Seed=)")
+    parser.add_argument("--output-path", help="content path for generated assets (-OutputPath=)")
+    parser.add_argument("--quality", help="quality level, e.g. Cinematic (-Quality=)")
+    parser.add_argument("--max-concurrent", type=int, help="characters in flight at once (-MaxConcurrent=)")
+    parser.add_argument("--shared", action="store_true",
+                        help="share the batch with other workers through the on-disk job queue (-Shared)")
+    parser.add_argument("--instance", type=int,
+                        help="worker number when several monitors run on one project; gives each its own heartbeat file")
+    args = parser.parse_args()
+    if args.commandlet and not args.manifest and not args.count:
+        parser.error("--commandlet needs --manifest or --count")
+    if args.shared and not args.manifest and args.seed is None:
+        parser.error("--shared needs --seed or --manifest so every worker joins the same batch")
+    return args
+
+def get_heartbeat_file(args):
+    if args.instance is None:
+        return HEARTBEAT_FILE
+    return HEARTBEAT_FILE.with_name(f"heartbeat_{args.instance}.txt")
+
+def build_editor_command(args):
+    heartbeat_args = [] if args.instance is None else [f"-HeartbeatFile={get_heartbeat_file(args)}"]
+    if not args.commandlet:
+        return [EDITOR_EXE, str(UPROJECT_FILE), "-AllowStdOutLogVerbosity"] + heartbeat_args
+
+    command = [find_editor_cmd_exe(EDITOR_EXE), str(UPROJECT_FILE), f"-run={COMMANDLET_NAME}"]
+    if args.manifest:
+        command.append(f"-Manifest={args.manifest}")
+    if args.count:
+        command.append(f"-Count={args.count}")
+    if args.seed is not None:
+        command.append(f"-Seed={args.seed}")
+    if args.output_path:
+        command.append(f"-OutputPath={args.output_path}")
+    if args.quality:
+        command.append(f"-Quality={args.quality}")
+    if args.max_concurrent:
+        command.append(f"-MaxConcurrent={args.max_concurrent}")
+    if args.shared:
+        command.append("-Shared")
+    command += heartbeat_args
+    command += ["-nullrhi", "-unattended", "-nosplash", "-nopause", "-stdout", "-AllowStdOutLogVerbosity"]
+    return command
+
 UPROJECT_FILE = find_uproject_file(PROJECT_ROOT)
 EDITOR_EXE = find_editor_exe()
 
 class HeartbeatMonitor:
-    def __init__(self):
+    def __init__(self, args):
+        self.commandlet = args.commandlet
+        self.editor_command = build_editor_command(args)
+        self.heartbeat_file = get_heartbeat_file(args)
+        self.editor_image_name = Path(self.editor_command[0]).name
+        self.startup_time = COMMANDLET_STARTUP_TIME if self.commandlet else STARTUP_TIME
         self.last_heartbeat_value = 0
         self.last_update_time = time.time()
         self.editor_process = None
@@ -47,8 +113,8 @@ class HeartbeatMonitor:
 
     def read_heartbeat(self):
         try:
-            if HEARTBEAT_FILE.exists():
-                with open(HEARTBEAT_FILE, 'r') as f:
+            if self.heartbeat_file.exists():
+                with open(self.heartbeat_file, 'r') as f:
                     content = f.read().strip()
                     if content.isdigit():
                         return int(content)
@@ -57,12 +123,15 @@ class HeartbeatMonitor:
         return None
 
     def start_editor(self):
-        print(f"[{self.get_timestamp()}] Starting Unreal Editor...")
+        print(f"[{self.get_timestamp()}] Starting {'batch commandlet' if self.commandlet else 'Unreal Editor'}...")
         try:
+            # The commandlet logs to stdout continuously, so let it write to our console instead of
+            # a pipe nobody reads (a full pipe would block the process and stop the heartbeat)
+            output = None if self.commandlet else subprocess.PIPE
             self.editor_process = subprocess.Popen(
-                [EDITOR_EXE, str(UPROJECT_FILE), "-AllowStdOutLogVerbosity"],
-                stdout=subprocess.PIPE,
-                stderr=subprocess.PIPE,
+                self.editor_command,
+                stdout=output,
+                stderr=output,
                 text=True
             )
             print(f"[{self.get_timestamp()}] Editor started with PID {self.editor_process.pid}")
@@ -74,7 +143,7 @@ class HeartbeatMonitor:
     def kill_editor(self):
         if self.editor_process is None:
             print(f"[{self.get_timestamp()}] Editor process not tracked, killing UnrealEditor via command line")
-            os.system("taskkill /IM UnrealEditor.exe /F")
+            os.system(f"taskkill /IM {self.editor_image_name} /F")
         else:
             print(f"[{self.get_timestamp()}] Killing editor process (PID {self.editor_process.pid})...")
             try:
@@ -84,14 +153,14 @@ class HeartbeatMonitor:
                     os.kill(self.editor_process.pid, signal.SIGKILL)
             except Exception as e:
                 print(f"[{self.get_timestamp()}] Error killing process: {e}")
-                os.system("taskkill /IM UnrealEditor.exe /F")
+                os.system(f"taskkill /IM {self.editor_image_name} /F")
 
         self.editor_process = None
         print(f"[{self.get_timestamp()}] Editor killed")
 
     def monitor(self):
         print(f"[{self.get_timestamp()}] Heartbeat monitor started")
-        print(f"[{self.get_timestamp()}] Heartbeat file: {HEARTBEAT_FILE}")
+        print(f"[{self.get_timestamp()}] Heartbeat file: {self.heartbeat_file}")
         print(f"[{self.get_timestamp()}] Timeout threshold: {HEARTBEAT_TIMEOUT} seconds")
         print(f"[{self.get_timestamp()}] Check interval: {HEARTBEAT_CHECK_INTERVAL} seconds")
 
@@ -102,8 +171,13 @@ class HeartbeatMonitor:
                 current_time = time.time()
 
                 if self.editor_process is not None:
-                    if self.editor_process.poll() is not None:
-                        print(f"[{self.get_timestamp()}] Editor process has exited")
+                    exit_code = self.editor_process.poll()
+                    if exit_code is not None:
+                        print(f"[{self.get_timestamp()}] Editor process has exited (code {exit_code})")
+                        # 0 = every character generated, 1 = finished with failures; both mean the batch is over
+                        if self.commandlet and exit_code in (0, 1):
+                            print(f"[{self.get_timestamp()}] Batch finished, monitor exiting")
+                            sys.exit(exit_code)
                         self.editor_process = None
                         time.sleep(2)
                         continue
@@ -132,7 +206,7 @@ class HeartbeatMonitor:
 
                 if self.editor_process is None or self.editor_process.poll() is not None:
                     if self.start_editor():
-                        time.sleep(STARTUP_TIME)
+                        time.sleep(self.startup_time)
                     self.last_heartbeat_value = 0
                     self.last_update_time = time.time()
 
@@ -152,5 +226,5 @@ class HeartbeatMonitor:
         return time.strftime("%Y-%m-%d %H:%M:%S")
 
 if __name__ == "__main__":
-    monitor = HeartbeatMonitor()
+    monitor = HeartbeatMonitor(parse_args())
     monitor.monitor()